@@ -19,6 +19,8 @@
 #include <oc/type/Ids.hpp>
 #include <oc/type/Callbacks.hpp>
 
+#include "hid/Keys.hpp"
+
 namespace Config {
 
 // ═══════════════════════════════════════════════════════════════════
@@ -75,6 +77,25 @@ constexpr std::array<oc::hal::common::embedded::ButtonDef, 2> BUTTONS = {{
     oc::hal::common::embedded::ButtonDef(2, oc::hal::common::embedded::GpioPin{35, oc::hal::common::embedded::GpioPin::Source::MCU}, true),  // AUX
 }};
 
+// ═══════════════════════════════════════════════════════════════════
+// Fine Adjust
+// ═══════════════════════════════════════════════════════════════════
+
+/// Button index (into BUTTONS) that enables fine adjust while held
+constexpr uint8_t FINE_BUTTON_INDEX = 0;
+
+/// Encoder movement scale while fine adjust is held
+constexpr float FINE_FACTOR = 0.1f;
+
+/// Encoders affected by fine adjust (bit i = ENCODERS[i])
+constexpr uint32_t FINE_ENCODER_MASK = 0b0111;
+
+/// Undo history depth (edits); button 1 held + button 2 press undoes one
+constexpr size_t UNDO_DEPTH = 32;
+
+/// Changes to the same control closer than this are one undo step
+constexpr uint32_t UNDO_COALESCE_MS = 1000;
+
 // ═══════════════════════════════════════════════════════════════════
 // MIDI Configuration
 // ═══════════════════════════════════════════════════════════════════
@@ -85,10 +106,164 @@ constexpr uint8_t MIDI_CHANNEL = 0;
 /// Base CC number for encoders (encoder 1 = CC 16, encoder 2 = CC 17, etc.)
 constexpr uint8_t ENCODER_CC_BASE = 16;
 
+/// Send continuous encoders as interpolated 14-bit CC (MSB = cc, LSB = cc + 32)
+constexpr bool ENCODER_14BIT = false;
+
+/// Output interval for interpolated 14-bit encoder positions (microseconds)
+constexpr uint32_t ENCODER_OUTPUT_INTERVAL_US = 1000;
+
+/// Encoder index (0-based) used as a discrete selector (e.g. waveform)
+constexpr uint8_t STEPPED_ENCODER_INDEX = 3;
+
+/// Number of discrete steps for the stepped encoder
+constexpr uint8_t STEPPED_ENCODER_STEPS = 4;
+
 /// CC number for button 1
 constexpr uint8_t BUTTON1_CC = 20;
 
 /// CC number for button 2
 constexpr uint8_t BUTTON2_CC = 21;
 
+/// CC number for button 2 double tap (momentary 127)
+constexpr uint8_t BUTTON2_DOUBLE_CC = 22;
+
+/// Align input scan + MIDI flush to USB (micro)frames (spins the loop)
+constexpr bool USB_FRAME_SYNC = false;
+
+/// Scan starts this long before the next SOF (must cover app->update())
+constexpr uint32_t USB_FRAME_LEAD_US = 60;
+
+// ═══════════════════════════════════════════════════════════════════
+// Modulation
+// ═══════════════════════════════════════════════════════════════════
+
+/// LFO rate in Hz
+constexpr float LFO_RATE_HZ = 0.5f;
+
+/// LFO → encoder 1 parameter depth (-1.0 to 1.0, 0 = not connected)
+constexpr float LFO_DEPTH = 0.0f;
+
+/// Incoming CC used as a modulation source (1 = mod wheel)
+constexpr uint8_t MOD_INPUT_CC = 1;
+
+/// Incoming mod CC → encoder 2 parameter depth (-1.0 to 1.0, 0 = not connected)
+constexpr float MOD_INPUT_DEPTH = 0.0f;
+
+/// LFO update interval while connected
+constexpr uint32_t MOD_UPDATE_INTERVAL_US = 1000;
+
+// ═══════════════════════════════════════════════════════════════════
+// Tempo, Arpeggiator, Note Repeat
+// ═══════════════════════════════════════════════════════════════════
+
+/// Internal tempo; with TEMPO_FROM_MIDI_CLOCK the host's MIDI clock drives it
+constexpr float TEMPO_BPM = 120.0f;
+constexpr bool TEMPO_FROM_MIDI_CLOCK = false;
+
+/// Arpeggiate held notes; encoders 1 and 2 then set rate and gate
+constexpr bool ARP_ENABLED = false;
+
+/// Incoming notes in this range (on MIDI_CHANNEL) are the held notes
+constexpr uint8_t ARP_INPUT_FIRST_NOTE = 48;
+constexpr uint8_t ARP_INPUT_NOTE_COUNT = 25;
+
+/// Arpeggiated notes go out on this channel (0-15), apart from the input
+constexpr uint8_t ARP_OUTPUT_CHANNEL = 1;
+
+/// Pattern: 0 up, 1 down, 2 up-down, 3 random, 4 as played
+constexpr uint8_t ARP_MODE = 0;
+
+/// Octave range (1-4)
+constexpr uint8_t ARP_OCTAVES = 1;
+
+/// Encoder indices bound to rate and gate while the arpeggiator is enabled
+constexpr uint8_t ARP_RATE_ENCODER = 0;
+constexpr uint8_t ARP_GATE_ENCODER = 1;
+
+/// Hold button 2 to repeat NOTE_REPEAT_NOTE (replaces the button 2 toggle)
+constexpr bool NOTE_REPEAT_ENABLED = false;
+constexpr uint8_t NOTE_REPEAT_NOTE = 36;
+constexpr uint8_t NOTE_REPEAT_CHANNEL = 9;  ///< 0-15 (9 = GM drums)
+
+/// Repeat rate: index into seq::DIVISIONS (6 = 1/16, 7 = 1/16T, 8 = 1/32)
+constexpr uint8_t NOTE_REPEAT_DIVISION = 6;
+
+/// Encoder index whose position sets the repeat velocity
+constexpr uint8_t NOTE_REPEAT_VELOCITY_ENCODER = 2;
+
+// ═══════════════════════════════════════════════════════════════════
+// Mackie Control
+// ═══════════════════════════════════════════════════════════════════
+
+/// Speak Mackie Control (MCU) instead of CCs: encoders are V-Pots, buttons
+/// send MCU notes, ring / meter / LCD feedback from the DAW is tracked
+constexpr bool MCU_ENABLED = false;
+
+/// Strip (0-7) of encoder 1's V-Pot; the other encoders take the next strips
+constexpr uint8_t MCU_FIRST_STRIP = 0;
+
+/// V-Pot ticks for a full encoder range before acceleration (18 = one per detent)
+constexpr float MCU_VPOT_TICKS_PER_RANGE = 18.0f;
+
+/// MCU note sent by each button (0x5E play, 0x5D stop; see mcu/Protocol.hpp)
+constexpr std::array<uint8_t, 2> MCU_BUTTON_NOTES = {0x5E, 0x5D};
+
+// ═══════════════════════════════════════════════════════════════════
+// HID Keyboard
+// ═══════════════════════════════════════════════════════════════════
+
+/// Button 2 sends a keyboard shortcut instead of its CC (build with `pio run -e hid`)
+constexpr bool HID_ENABLED = false;
+
+/// The shortcut: Ctrl+S (save in most DAWs; use mod::GUI for Cmd on macOS)
+constexpr minimal::hid::Chord HID_BUTTON2_CHORD = {minimal::hid::mod::CTRL,
+                                                   minimal::hid::key::letter('s')};
+
+// ═══════════════════════════════════════════════════════════════════
+// Motion (IMU)
+// ═══════════════════════════════════════════════════════════════════
+
+/// MPU-6050 on Wire1 (pin 16 SCL1, 17 SDA1), read by DMA from a timer
+constexpr bool MOTION_ENABLED = false;
+constexpr uint8_t IMU_I2C_ADDRESS = 0x68;  ///< 0x69 with AD0 high
+
+/// Sensor reads per second (one ~0.45 ms bus transaction each at 400 kHz)
+constexpr uint32_t MOTION_RATE_HZ = 200;
+
+/// Roll → encoder 1 parameter, shake → encoder 2 parameter depth (-1.0 to 1.0, 0 = not connected)
+constexpr float MOTION_TILT_DEPTH = 0.5f;
+constexpr float MOTION_SHAKE_DEPTH = 0.0f;
+
+// ═══════════════════════════════════════════════════════════════════
+// State Persistence
+// ═══════════════════════════════════════════════════════════════════
+
+/// Flash journal for encoder positions and toggle states (below EEPROM emulation).
+/// The linker's FLASH region ends here (scripts/hotcold_ld.py), up to the EEPROM.
+constexpr uint32_t STATE_JOURNAL_ADDRESS = 0x607BE000;
+
+/// Journal size in 4 KB sectors (wear is spread over all of them)
+constexpr uint32_t STATE_JOURNAL_SECTORS = 2;
+
+/// Save once the state has been unchanged for this long
+constexpr uint32_t STATE_SAVE_QUIET_MS = 1000;
+
+/// Save at the latest this long after the first unsaved change
+constexpr uint32_t STATE_SAVE_MAX_DELAY_MS = 5000;
+
+/// Re-send the restored state as one MIDI burst after USB enumeration
+constexpr bool RESEND_STATE_AT_BOOT = true;
+
+/// Delay between USB enumeration and the state burst (host MIDI setup)
+constexpr uint32_t STATE_RESEND_DELAY_MS = 500;
+
+/// Supply monitor input, LOW when the supply is failing (PowerFail::NO_PIN = none)
+constexpr uint8_t POWER_FAIL_PIN = 0xFF;
+
+/// Treat loss of USB VBUS as power failure (bus-powered controller)
+constexpr bool POWER_FAIL_ON_VBUS_LOSS = true;
+
+/// Time the supply holds after the warning (bulk capacitance / load current)
+constexpr uint32_t POWER_FAIL_HOLDUP_US = 5000;
+
 }  // namespace Config
@@ -0,0 +1,31 @@
+#pragma once
+
+/**
+ * @file Benchmarks.hpp
+ * @brief On-device micro-benchmarks (OC_BENCH builds only)
+ *
+ * Built with -D OC_BENCH (see [env:bench] in platformio.ini). run() is
+ * called once from setup() and prints one line per case, in CPU cycles
+ * measured with the DWT cycle counter:
+ *
+ *   BENCH <name> <cycles per op>
+ *   BENCH END
+ *
+ * Without OC_BENCH run() is an empty inline.
+ * Implementation: src/bench/Benchmarks.cpp
+ */
+
+namespace minimal::bench {
+
+#if defined(OC_BENCH) && defined(__IMXRT1062__)
+
+/// Run every benchmark and print the results over serial (blocking)
+void run();
+
+#else
+
+inline void run() {}
+
+#endif
+
+}  // namespace minimal::bench
@@ -0,0 +1,107 @@
+#pragma once
+
+/**
+ * @file ScheduledContext.hpp
+ * @brief Update policies for contexts: never, fixed rate, or on wake request
+ *
+ * The framework calls IContext::update() on every loop() iteration. Most
+ * contexts have nothing to do most of the time. ScheduledContext owns
+ * update() and only forwards to the derived class's tick() when its policy
+ * says so:
+ *
+ * - UpdatePolicy::never()         : tick() is never called
+ * - UpdatePolicy::fixedRate(us)   : at most once per interval
+ * - UpdatePolicy::onWake()        : once after each wake() (ISR-safe)
+ *
+ * tick() must be public. A derived class without one is detected at compile time and
+ * update() compiles to an empty function, whatever the policy.
+ *
+ * @code
+ * class MyContext : public minimal::context::ScheduledContext<MyContext> {
+ * public:
+ *     void tick() { ... }  // optional
+ * };
+ * @endcode
+ *
+ * The remaining per-loop cost is the framework's virtual update() call
+ * plus one flag test; skipping the call itself needs framework support.
+ */
+
+#include <cstdint>
+#include <atomic>
+#include <type_traits>
+
+#include <Arduino.h>
+
+#include <oc/context/ContextBase.hpp>
+
+namespace minimal::context {
+
+class UpdatePolicy {
+public:
+    enum class Mode : uint8_t { Never, FixedRate, OnWake };
+
+    static constexpr UpdatePolicy never() { return {Mode::Never, 0}; }
+    static constexpr UpdatePolicy fixedRate(uint32_t intervalUs) {
+        return {Mode::FixedRate, intervalUs};
+    }
+    static constexpr UpdatePolicy onWake() { return {Mode::OnWake, 0}; }
+
+    constexpr Mode mode() const { return mode_; }
+    constexpr uint32_t intervalUs() const { return intervalUs_; }
+
+private:
+    constexpr UpdatePolicy(Mode mode, uint32_t intervalUs) : mode_(mode), intervalUs_(intervalUs) {}
+
+    Mode mode_;
+    uint32_t intervalUs_;
+};
+
+namespace detail {
+
+template <typename T, typename = void>
+struct HasTick : std::false_type {};
+
+template <typename T>
+struct HasTick<T, std::void_t<decltype(std::declval<T&>().tick())>> : std::true_type {};
+
+}  // namespace detail
+
+template <typename Derived>
+class ScheduledContext : public oc::context::ContextBase {
+public:
+    void update() final {
+        if constexpr (detail::HasTick<Derived>::value) {
+            if (due()) static_cast<Derived*>(this)->tick();
+        }
+    }
+
+    /// Request one tick() at the next update (OnWake policy, ISR-safe)
+    void wake() { wake_.store(true, std::memory_order_relaxed); }
+
+protected:
+    void setUpdatePolicy(UpdatePolicy policy) { policy_ = policy; }
+
+private:
+    bool due() {
+        switch (policy_.mode()) {
+            case UpdatePolicy::Mode::Never: return false;
+            case UpdatePolicy::Mode::OnWake:
+                return wake_.load(std::memory_order_relaxed) &&
+                       wake_.exchange(false, std::memory_order_relaxed);
+            case UpdatePolicy::Mode::FixedRate: {
+                uint32_t now = micros();
+                if (now - lastTickUs_ < policy_.intervalUs()) return false;
+                lastTickUs_ = now;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    UpdatePolicy policy_ = UpdatePolicy::onWake();
+    std::atomic<bool> wake_{false};
+    uint32_t lastTickUs_ = 0;
+};
+
+}  // namespace minimal::context
@@ -0,0 +1,192 @@
+#pragma once
+
+/**
+ * @file Kernels.hpp
+ * @brief Batch kernels over arrays of Q15 / Q31 values
+ *
+ * Mapping, curves, smoothing and morphing applied to a whole array at a
+ * time instead of one float per callback. Q15 kernels load two values per
+ * word and use the dual-lane instructions from dsp/Simd.hpp (QADD16,
+ * SMLAD, USAT16); Q31 kernels use QADD / SMMUL(R). Off-target the same code
+ * runs on the portable primitives with bit-identical results.
+ *
+ * Unipolar Q15 (0..32767) is the normalized 0-1 range used for parameter
+ * values; mix() and smooth() take their position / coefficient in it.
+ *
+ * Each kernel states its error against the exact result; test/test_dsp
+ * checks them against a double-precision reference.
+ *
+ * @code
+ * int16_t bankA[64], bankB[64], morphed[64];
+ * uint8_t cc[64];
+ * dsp::mix(bankA, bankB, dsp::toQ15(morph), morphed, 64);   // morph two banks
+ * dsp::curve(morphed, CURVE_LOG, morphed, 64);              // response curve
+ * dsp::toMidi7(morphed, cc, 64);                            // 0-127
+ * @endcode
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "dsp/Simd.hpp"
+
+namespace minimal::dsp {
+
+/// Points of a curve() table: 32 linear segments over 0..32767
+constexpr size_t CURVE_POINTS = 33;
+
+namespace detail {
+
+inline uint32_t load2(const int16_t* p) {
+    uint32_t word;
+    std::memcpy(&word, p, sizeof(word));  // single LDR (unaligned is fine on the M7)
+    return word;
+}
+
+inline void store2(int16_t* p, uint32_t word) { std::memcpy(p, &word, sizeof(word)); }
+
+inline int16_t lo(uint32_t word) { return static_cast<int16_t>(word); }
+inline int16_t hi(uint32_t word) { return static_cast<int16_t>(word >> 16); }
+
+/// (a·(32768 - t) + b·t) / 32768, rounded; t in 0..32767
+inline int16_t lerp(int16_t a, int16_t b, int16_t t) {
+    // 32768 - t does not fit a lane: a·(32767 - t) + a is the same product
+    int32_t acc = smlad(pack16(a, b), pack16(static_cast<int16_t>(INT16_MAX - t), t),
+                        a + (1 << 14));
+    return static_cast<int16_t>(acc >> 15);
+}
+
+}  // namespace detail
+
+// ── Q15 ──
+
+/// out = saturate(a + b)
+inline void add(const int16_t* a, const int16_t* b, int16_t* out, size_t n) {
+    size_t i = 0;
+    for (; i + 1 < n; i += 2) {
+        detail::store2(out + i, qadd16(detail::load2(a + i), detail::load2(b + i)));
+    }
+    if (i < n) out[i] = saturate16(a[i] + b[i]);
+}
+
+/// out = saturate(in · gain), gain in Q15; truncated (up to 1 LSB low)
+inline void scale(const int16_t* in, int16_t gain, int16_t* out, size_t n) {
+    for (size_t i = 0; i < n; ++i) out[i] = saturate16((in[i] * gain) >> 15);
+}
+
+/**
+ * @brief Morph: out = a + (b - a) · t, t unipolar Q15 (0 = a, 32767 ≈ b)
+ *
+ * One SMLAD per value, rounded (within 0.5 LSB), never overflows (result
+ * lies between a and b). @p out may alias @p a or @p b.
+ */
+inline void mix(const int16_t* a, const int16_t* b, int16_t t, int16_t* out, size_t n) {
+    if (t < 0) t = 0;
+    size_t i = 0;
+    for (; i + 1 < n; i += 2) {
+        uint32_t wa = detail::load2(a + i);
+        uint32_t wb = detail::load2(b + i);
+        detail::store2(out + i, pack16(detail::lerp(detail::lo(wa), detail::lo(wb), t),
+                                       detail::lerp(detail::hi(wa), detail::hi(wb), t)));
+    }
+    if (i < n) out[i] = detail::lerp(a[i], b[i], t);
+}
+
+/**
+ * @brief One-pole smoothing step: state moves @p coeff of the way to target
+ *
+ * Call once per update; coeff is unipolar Q15 (larger = faster).
+ */
+inline void smooth(int16_t* state, const int16_t* target, int16_t coeff, size_t n) {
+    mix(state, target, coeff, state, n);
+}
+
+/**
+ * @brief Piecewise-linear response curve
+ * @param table CURVE_POINTS outputs at inputs 0, 1024, ..., 32767
+ *
+ * Rounded like mix() (within 0.5 LSB of the straight line between the two
+ * points). Negative inputs clamp to 0. @p out may alias @p in.
+ */
+inline void curve(const int16_t* in, const int16_t (&table)[CURVE_POINTS], int16_t* out,
+                  size_t n) {
+    auto at = [&](int16_t v) {
+        uint32_t segment = static_cast<uint32_t>(v) >> 10;
+        auto frac = static_cast<int16_t>((v & 0x3FF) << 5);
+        return detail::lerp(table[segment], table[segment + 1], frac);
+    };
+    size_t i = 0;
+    for (; i + 1 < n; i += 2) {
+        uint32_t w = usat16x15(detail::load2(in + i));
+        detail::store2(out + i, pack16(at(detail::lo(w)), at(detail::hi(w))));
+    }
+    if (i < n) out[i] = at(in[i] < 0 ? 0 : in[i]);
+}
+
+/// Unipolar Q15 → 0-127, rounded (same codes as `v * 127.0f + 0.5f`)
+inline void toMidi7(const int16_t* in, uint8_t* out, size_t n) {
+    size_t i = 0;
+    for (; i + 1 < n; i += 2) {
+        uint32_t w = usat16x15(detail::load2(in + i));
+        out[i] = static_cast<uint8_t>((detail::lo(w) * 127 + (1 << 14)) >> 15);
+        out[i + 1] = static_cast<uint8_t>((detail::hi(w) * 127 + (1 << 14)) >> 15);
+    }
+    if (i < n) out[i] = static_cast<uint8_t>(((in[i] < 0 ? 0 : in[i]) * 127 + (1 << 14)) >> 15);
+}
+
+/// Unipolar Q15 → 0-16383, rounded
+inline void toMidi14(const int16_t* in, uint16_t* out, size_t n) {
+    size_t i = 0;
+    for (; i + 1 < n; i += 2) {
+        uint32_t w = usat16x15(detail::load2(in + i));
+        out[i] = static_cast<uint16_t>((detail::lo(w) * 16383 + (1 << 14)) >> 15);
+        out[i + 1] = static_cast<uint16_t>((detail::hi(w) * 16383 + (1 << 14)) >> 15);
+    }
+    if (i < n) {
+        out[i] = static_cast<uint16_t>(((in[i] < 0 ? 0 : in[i]) * 16383 + (1 << 14)) >> 15);
+    }
+}
+
+/// Normalized floats → Q15 (array boundary with float APIs)
+inline void toQ15(const float* in, int16_t* out, size_t n) {
+    for (size_t i = 0; i < n; ++i) out[i] = toQ15(in[i]);
+}
+
+inline void fromQ15(const int16_t* in, float* out, size_t n) {
+    for (size_t i = 0; i < n; ++i) out[i] = fromQ15(in[i]);
+}
+
+// ── Q31 ──
+
+/// out = saturate(a + b)
+inline void add(const int32_t* a, const int32_t* b, int32_t* out, size_t n) {
+    for (size_t i = 0; i < n; ++i) out[i] = qadd(a[i], b[i]);
+}
+
+/// out = saturate(in · gain), gain in Q31; truncated (up to 2 LSBs low)
+inline void scale(const int32_t* in, int32_t gain, int32_t* out, size_t n) {
+    for (size_t i = 0; i < n; ++i) {
+        int32_t q30 = smmul(in[i], gain);
+        out[i] = qadd(q30, q30);
+    }
+}
+
+/**
+ * @brief Morph: out = a + (b - a) · t, t unipolar Q31
+ *
+ * Within 3 LSBs: halving a and b costs up to 1, the rounded product up to
+ * 2 once doubled back. Saturates at full scale.
+ */
+inline void mix(const int32_t* a, const int32_t* b, int32_t t, int32_t* out, size_t n) {
+    if (t < 0) t = 0;
+    for (size_t i = 0; i < n; ++i) {
+        // Worked at half scale: the half-delta and the half result both fit 32 bits
+        int32_t halfDelta = (b[i] >> 1) - (a[i] >> 1);
+        auto half = static_cast<int32_t>(static_cast<uint32_t>(a[i] >> 1) +
+                                         (static_cast<uint32_t>(smmulr(halfDelta, t)) << 1));
+        out[i] = qadd(half, half);
+    }
+}
+
+}  // namespace minimal::dsp
@@ -0,0 +1,37 @@
+#pragma once
+
+/**
+ * @file Lfo.hpp
+ * @brief Fixed-point low-frequency oscillator (modulation source)
+ *
+ * 32-bit phase accumulator advanced by elapsed time, so the rate does not
+ * depend on how often it is polled. Output is a bipolar Q15 triangle.
+ */
+
+#include <cstdint>
+
+namespace minimal::dsp {
+
+class Lfo {
+public:
+    explicit Lfo(float rateHz) { setRate(rateHz); }
+
+    void setRate(float rateHz) {
+        // Phase units per µs: 2^32 per cycle
+        incrementPerUs_ = static_cast<uint32_t>(rateHz * 4294.967296f + 0.5f);
+    }
+
+    /// Advance by @p elapsedUs and return the new output (Q15, -1..1)
+    int16_t advance(uint32_t elapsedUs) {
+        phase_ += incrementPerUs_ * elapsedUs;
+        // Triangle: fold the top bit, then map 0..2^31 to -32768..32767
+        uint32_t folded = (phase_ & 0x80000000u) ? ~phase_ : phase_;
+        return static_cast<int16_t>(static_cast<int32_t>(folded >> 15) - 32768);
+    }
+
+private:
+    uint32_t phase_ = 0;
+    uint32_t incrementPerUs_ = 0;
+};
+
+}  // namespace minimal::dsp
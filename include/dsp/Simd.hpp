@@ -0,0 +1,164 @@
+#pragma once
+
+/**
+ * @file Simd.hpp
+ * @brief Cortex-M7 DSP extension primitives with portable equivalents
+ *
+ * The M7 packs two Q15 values in one register and multiplies both pairs
+ * in a single instruction (SMLAD; SMLALD with a 64-bit accumulator). On
+ * device these compile to the instruction; off-target the portable
+ * versions give bit-identical results, so code built on them can be
+ * checked on the host.
+ */
+
+#include <cstdint>
+
+namespace minimal::dsp {
+
+#if defined(__ARM_FEATURE_DSP) && __ARM_FEATURE_DSP
+#define MINIMAL_DSP_SIMD 1
+#else
+#define MINIMAL_DSP_SIMD 0
+#endif
+
+/// Two Q15 values in one word: @p lo in bits 0-15, @p hi in bits 16-31
+inline uint32_t pack16(int16_t lo, int16_t hi) {
+    return static_cast<uint16_t>(lo) | (static_cast<uint32_t>(static_cast<uint16_t>(hi)) << 16);
+}
+
+/// acc + a.lo * b.lo + a.hi * b.hi
+inline int32_t smlad(uint32_t a, uint32_t b, int32_t acc) {
+#if MINIMAL_DSP_SIMD
+    int32_t result;
+    asm("smlad %0, %1, %2, %3" : "=r"(result) : "r"(a), "r"(b), "r"(acc));
+    return result;
+#else
+    int32_t lo = static_cast<int16_t>(a & 0xFFFF) * static_cast<int16_t>(b & 0xFFFF);
+    int32_t hi = static_cast<int16_t>(a >> 16) * static_cast<int16_t>(b >> 16);
+    return static_cast<int32_t>(static_cast<uint32_t>(acc) + static_cast<uint32_t>(lo) +
+                                static_cast<uint32_t>(hi));
+#endif
+}
+
+/// 64-bit accumulating form of smlad (cannot overflow for any practical count)
+inline int64_t smlald(uint32_t a, uint32_t b, int64_t acc) {
+#if MINIMAL_DSP_SIMD
+    uint32_t lo = static_cast<uint32_t>(acc);
+    uint32_t hi = static_cast<uint32_t>(static_cast<uint64_t>(acc) >> 32);
+    asm("smlald %0, %1, %2, %3" : "+r"(lo), "+r"(hi) : "r"(a), "r"(b));
+    return static_cast<int64_t>((static_cast<uint64_t>(hi) << 32) | lo);
+#else
+    int32_t lo = static_cast<int16_t>(a & 0xFFFF) * static_cast<int16_t>(b & 0xFFFF);
+    int32_t hi = static_cast<int16_t>(a >> 16) * static_cast<int16_t>(b >> 16);
+    return acc + lo + hi;
+#endif
+}
+
+/// Saturate to the Q15 range
+inline int16_t saturate16(int32_t v) {
+#if MINIMAL_DSP_SIMD
+    int32_t result;
+    asm("ssat %0, #16, %1" : "=r"(result) : "r"(v));
+    return static_cast<int16_t>(result);
+#else
+    if (v > INT16_MAX) return INT16_MAX;
+    if (v < INT16_MIN) return INT16_MIN;
+    return static_cast<int16_t>(v);
+#endif
+}
+
+/// Lane-wise saturating add of two Q15 pairs
+inline uint32_t qadd16(uint32_t a, uint32_t b) {
+#if MINIMAL_DSP_SIMD
+    uint32_t result;
+    asm("qadd16 %0, %1, %2" : "=r"(result) : "r"(a), "r"(b));
+    return result;
+#else
+    return pack16(saturate16(static_cast<int16_t>(a) + static_cast<int16_t>(b)),
+                  saturate16(static_cast<int16_t>(a >> 16) + static_cast<int16_t>(b >> 16)));
+#endif
+}
+
+/// Lane-wise saturating subtract (a - b) of two Q15 pairs
+inline uint32_t qsub16(uint32_t a, uint32_t b) {
+#if MINIMAL_DSP_SIMD
+    uint32_t result;
+    asm("qsub16 %0, %1, %2" : "=r"(result) : "r"(a), "r"(b));
+    return result;
+#else
+    return pack16(saturate16(static_cast<int16_t>(a) - static_cast<int16_t>(b)),
+                  saturate16(static_cast<int16_t>(a >> 16) - static_cast<int16_t>(b >> 16)));
+#endif
+}
+
+/// a.lo * b.lo + a.hi * b.hi (dual multiply, no accumulator)
+inline int32_t smuad(uint32_t a, uint32_t b) {
+#if MINIMAL_DSP_SIMD
+    int32_t result;
+    asm("smuad %0, %1, %2" : "=r"(result) : "r"(a), "r"(b));
+    return result;
+#else
+    return smlad(a, b, 0);
+#endif
+}
+
+/// Lane-wise clamp of two signed 16-bit values to 0..2^15-1 (unipolar Q15)
+inline uint32_t usat16x15(uint32_t a) {
+#if MINIMAL_DSP_SIMD
+    uint32_t result;
+    asm("usat16 %0, #15, %1" : "=r"(result) : "r"(a));
+    return result;
+#else
+    int16_t lo = static_cast<int16_t>(a);
+    int16_t hi = static_cast<int16_t>(a >> 16);
+    return pack16(lo < 0 ? 0 : lo, hi < 0 ? 0 : hi);
+#endif
+}
+
+/// Saturating 32-bit add (Q31)
+inline int32_t qadd(int32_t a, int32_t b) {
+#if MINIMAL_DSP_SIMD
+    int32_t result;
+    asm("qadd %0, %1, %2" : "=r"(result) : "r"(a), "r"(b));
+    return result;
+#else
+    int64_t sum = static_cast<int64_t>(a) + b;
+    if (sum > INT32_MAX) return INT32_MAX;
+    if (sum < INT32_MIN) return INT32_MIN;
+    return static_cast<int32_t>(sum);
+#endif
+}
+
+/// Top 32 bits of the 64-bit product (Q31 × Q31 → Q30)
+inline int32_t smmul(int32_t a, int32_t b) {
+#if MINIMAL_DSP_SIMD
+    int32_t result;
+    asm("smmul %0, %1, %2" : "=r"(result) : "r"(a), "r"(b));
+    return result;
+#else
+    return static_cast<int32_t>((static_cast<int64_t>(a) * b) >> 32);
+#endif
+}
+
+/// smmul() rounded to nearest instead of floored
+inline int32_t smmulr(int32_t a, int32_t b) {
+#if MINIMAL_DSP_SIMD
+    int32_t result;
+    asm("smmulr %0, %1, %2" : "=r"(result) : "r"(a), "r"(b));
+    return result;
+#else
+    return static_cast<int32_t>((static_cast<int64_t>(a) * b + 0x80000000LL) >> 32);
+#endif
+}
+
+/// Normalized float (-1..1) to Q15, saturated
+inline int16_t toQ15(float v) {
+    float scaled = v * 32768.0f;
+    if (scaled >= 32767.0f) return INT16_MAX;
+    if (scaled <= -32768.0f) return INT16_MIN;
+    return static_cast<int16_t>(scaled >= 0.0f ? scaled + 0.5f : scaled - 0.5f);
+}
+
+inline float fromQ15(int16_t v) { return static_cast<float>(v) * (1.0f / 32768.0f); }
+
+}  // namespace minimal::dsp
@@ -0,0 +1,132 @@
+#pragma once
+
+/**
+ * @file HidOutput.hpp
+ * @brief USB HID keyboard / media-key output next to MIDI
+ *
+ * For DAW shortcuts instead of MIDI mappings:
+ *
+ * @code
+ * onButton(id).press().then([this] { hid().key(hid::key::letter('s'), hid::mod::CTRL); });
+ * onButton(id).press().then([this] { hid().consumer(hid::consumer::PLAY_PAUSE); });
+ * @endcode
+ *
+ * Calls only queue (hid/ReportBatcher.hpp). poll(), from loop(), sends at
+ * most one keyboard and one consumer report per USB frame. The frame
+ * number is the controller's frame index (USB1_FRINDEX), so nothing is
+ * sent while the bus is suspended (no frames). The core's report write
+ * waits only when all of its transfers are still unread, and one report
+ * per frame cannot fill them, so it never blocks.
+ *
+ * Needs a USB type with a keyboard interface: the `hid` PlatformIO
+ * environment builds with USB_EVERYTHING (MIDI + serial + keyboard, the
+ * core's composite type). The keyboard endpoint is polled every 1 ms
+ * (KEYBOARD_INTERVAL in the core's usb_desc.h). In other builds
+ * available() is false and every call is dropped and counted.
+ */
+
+#include <cstdint>
+
+#include <Arduino.h>
+
+#include "hid/Keys.hpp"
+#include "hid/ReportBatcher.hpp"
+#include "metrics/Metrics.hpp"
+#include "midi/UsbConnection.hpp"
+
+namespace minimal::hid {
+
+class HidOutput {
+public:
+    /// True when the USB type includes a keyboard interface
+    static constexpr bool available() {
+#if defined(__IMXRT1062__) && defined(KEYBOARD_INTERFACE)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /// Press and release a shortcut (two reports, one frame apart)
+    bool key(uint8_t usage, uint8_t modifiers = 0) { return key(Chord{modifiers, usage}); }
+    bool key(Chord chord) { return accept(available() && batcher_.tap(chord)); }
+
+    /// Hold a shortcut down until release() (e.g. a button held as Shift)
+    bool press(Chord chord) { return accept(available() && batcher_.press(chord)); }
+    bool release(Chord chord) { return available() && batcher_.release(chord); }
+
+    /// Press and release a media key (hid::consumer::*)
+    bool consumer(uint16_t usage) { return accept(available() && batcher_.consumer(usage)); }
+
+    /**
+     * @brief Send the report due in this USB frame; call every loop
+     * @return true while reports are pending
+     */
+    bool poll() {
+        if (!batcher_.pending() || !midi::usbConfigured()) return batcher_.pending();
+        Port port;
+        uint32_t before = batcher_.reports();
+        bool pending = batcher_.poll(frame(), port);
+        reports_.add(batcher_.reports() - before);
+        return pending;
+    }
+
+private:
+    struct Port {
+        bool sendKeyboard(uint8_t modifiers, const uint8_t keys[6]) {
+#if defined(__IMXRT1062__) && defined(KEYBOARD_INTERFACE)
+            Keyboard.set_modifier(modifiers);
+            Keyboard.set_key1(keys[0]);
+            Keyboard.set_key2(keys[1]);
+            Keyboard.set_key3(keys[2]);
+            Keyboard.set_key4(keys[3]);
+            Keyboard.set_key5(keys[4]);
+            Keyboard.set_key6(keys[5]);
+            Keyboard.send_now();
+#else
+            (void)modifiers;
+            (void)keys;
+#endif
+            return true;
+        }
+
+        bool sendConsumer(uint16_t usage, bool pressed) {
+#if defined(__IMXRT1062__) && defined(KEYBOARD_INTERFACE)
+            uint16_t code = static_cast<uint16_t>(0xE400 | usage);  // core's KEY_MEDIA_* encoding
+            if (pressed) {
+                Keyboard.press(code);
+            } else {
+                Keyboard.release(code);
+            }
+#else
+            (void)usage;
+            (void)pressed;
+#endif
+            return true;
+        }
+    };
+
+    /// USB frame number (1 ms), advancing only while the host sends frames
+    static uint32_t frame() {
+#if defined(__IMXRT1062__)
+        return (USB1_FRINDEX & 0x3FFF) >> 3;
+#else
+        return millis();
+#endif
+    }
+
+    bool accept(bool queued) {
+        if (!queued) dropped_.inc();
+        return queued;
+    }
+
+    ReportBatcher<8> batcher_;
+
+    inline static metrics::Counter reports_{"hid.reports"};
+    inline static metrics::Counter dropped_{"hid.dropped"};
+};
+
+/// The example's HID output (ScheduledContext::hid())
+inline HidOutput usbHid;
+
+}  // namespace minimal::hid
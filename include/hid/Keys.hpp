@@ -0,0 +1,80 @@
+#pragma once
+
+/**
+ * @file Keys.hpp
+ * @brief HID usages for keyboard shortcuts and media keys
+ *
+ * Keyboard usages are from the HID usage tables, page 0x07. The modifier
+ * keys are usages 0xE0-0xE7 there, and bit n of the report's modifier
+ * byte is usage 0xE0 + n. Consumer usages are page 0x0C.
+ */
+
+#include <cstdint>
+
+namespace minimal::hid {
+
+/// Modifier bits (boot keyboard report, byte 0)
+namespace mod {
+constexpr uint8_t CTRL = 0x01;
+constexpr uint8_t SHIFT = 0x02;
+constexpr uint8_t ALT = 0x04;   ///< Option on macOS
+constexpr uint8_t GUI = 0x08;   ///< Cmd on macOS, Win on Windows
+constexpr uint8_t RIGHT_CTRL = 0x10;
+constexpr uint8_t RIGHT_SHIFT = 0x20;
+constexpr uint8_t RIGHT_ALT = 0x40;
+constexpr uint8_t RIGHT_GUI = 0x80;
+}  // namespace mod
+
+/// Keyboard usages (page 0x07)
+namespace key {
+constexpr uint8_t NONE = 0x00;
+constexpr uint8_t ENTER = 0x28;
+constexpr uint8_t ESCAPE = 0x29;
+constexpr uint8_t BACKSPACE = 0x2A;
+constexpr uint8_t TAB = 0x2B;
+constexpr uint8_t SPACE = 0x2C;
+constexpr uint8_t F1 = 0x3A;  ///< F1-F12 are consecutive
+constexpr uint8_t HOME = 0x4A;
+constexpr uint8_t PAGE_UP = 0x4B;
+constexpr uint8_t DELETE = 0x4C;
+constexpr uint8_t END = 0x4D;
+constexpr uint8_t PAGE_DOWN = 0x4E;
+constexpr uint8_t RIGHT = 0x4F;
+constexpr uint8_t LEFT = 0x50;
+constexpr uint8_t DOWN = 0x51;
+constexpr uint8_t UP = 0x52;
+
+/// Usage of a letter ('a'-'z', either case) on a US layout
+constexpr uint8_t letter(char c) { return static_cast<uint8_t>(0x04 + ((c | 0x20) - 'a')); }
+
+/// Usage of a digit ('0'-'9', top row)
+constexpr uint8_t digit(char c) { return c == '0' ? 0x27 : static_cast<uint8_t>(0x1E + (c - '1')); }
+
+/// First modifier usage (0xE0 + modifier bit index)
+constexpr uint8_t FIRST_MODIFIER = 0xE0;
+}  // namespace key
+
+/// Consumer control usages (page 0x0C)
+namespace consumer {
+constexpr uint16_t RECORD = 0xB2;
+constexpr uint16_t FAST_FORWARD = 0xB3;
+constexpr uint16_t REWIND = 0xB4;
+constexpr uint16_t NEXT_TRACK = 0xB5;
+constexpr uint16_t PREVIOUS_TRACK = 0xB6;
+constexpr uint16_t STOP = 0xB7;
+constexpr uint16_t PLAY_PAUSE = 0xCD;
+constexpr uint16_t MUTE = 0xE2;
+constexpr uint16_t VOLUME_UP = 0xE9;
+constexpr uint16_t VOLUME_DOWN = 0xEA;
+}  // namespace consumer
+
+/// A shortcut: modifiers plus at most one key (key::NONE for modifiers only)
+struct Chord {
+    uint8_t modifiers;
+    uint8_t key;
+};
+
+static_assert(key::letter('s') == 0x16 && key::letter('S') == 0x16, "letter usages");
+static_assert(key::digit('1') == 0x1E && key::digit('0') == 0x27, "digit usages");
+
+}  // namespace minimal::hid
@@ -0,0 +1,226 @@
+#pragma once
+
+/**
+ * @file ReportBatcher.hpp
+ * @brief Key events → at most one HID report per USB frame
+ *
+ * The host polls the keyboard endpoint once per frame (1 ms), so a report
+ * replaced before the poll is lost. Events are therefore batched. All
+ * changes made between two polls go into one report: a chord pressed from
+ * a button callback is one report with its modifiers and key together.
+ * A key that would press and release (or release and press) within the
+ * same pending report starts a new one instead, so every stroke reaches
+ * the host. poll() sends the oldest pending report once per new frame.
+ *
+ * When the queue is full, changes merge into the newest pending report.
+ * A stroke may then be lost, but the final key state always is right, so
+ * no key stays stuck.
+ *
+ * Consumer (media) keys go on a separate queue of press / release events,
+ * with one event per frame.
+ *
+ * No Arduino dependency: the frame number and the transport are passed in,
+ * so the batching can be tested on the host.
+ *
+ * A Port provides:
+ *   bool sendKeyboard(uint8_t modifiers, const uint8_t keys[6]);  // false: retry next frame
+ *   bool sendConsumer(uint16_t usage, bool pressed);
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include "hid/Keys.hpp"
+
+namespace minimal::hid {
+
+/// Keyboard usages 0x00-0xFF as a bitset (modifiers are 0xE0-0xE7)
+struct KeySet {
+    uint32_t words[8] = {};
+
+    bool test(uint8_t usage) const { return (words[usage >> 5] >> (usage & 31)) & 1u; }
+    void set(uint8_t usage) { words[usage >> 5] |= 1u << (usage & 31); }
+
+    /// Modifiers + up to 6 keys; more than 6 keys are not reported
+    uint8_t toReport(uint8_t keys[6]) const {
+        uint8_t count = 0;
+        for (uint8_t w = 0; w < 7 && count < 6; ++w) {  // words 0-6: usages below 0xE0
+            uint32_t bits = words[w];
+            while (bits && count < 6) {
+                keys[count++] = static_cast<uint8_t>(w * 32 + __builtin_ctz(bits));
+                bits &= bits - 1;
+            }
+        }
+        for (uint8_t k = count; k < 6; ++k) keys[k] = 0;
+        return static_cast<uint8_t>(words[7]);  // 0xE0-0xE7: modifier bits
+    }
+
+    bool operator==(const KeySet& other) const {
+        for (uint8_t w = 0; w < 8; ++w) {
+            if (words[w] != other.words[w]) return false;
+        }
+        return true;
+    }
+};
+
+template <uint8_t Depth = 8>
+class ReportBatcher {
+    static_assert(Depth >= 2, "a tap needs two reports");
+
+public:
+    /// Most chords held at once (boot reports carry 6 keys)
+    static constexpr uint8_t MAX_HELD = 6;
+
+    // ── Keyboard ──
+
+    /// Hold a chord down; @return false if MAX_HELD chords are already held
+    bool press(Chord chord) {
+        if (held_ == MAX_HELD) return false;
+        chords_[held_++] = chord;
+        update();
+        return true;
+    }
+
+    /// Let go of a held chord (its modifiers stay down if another chord holds them)
+    bool release(Chord chord) {
+        for (uint8_t k = 0; k < held_; ++k) {
+            if (chords_[k].key != chord.key || chords_[k].modifiers != chord.modifiers) continue;
+            chords_[k] = chords_[--held_];
+            update();
+            return true;
+        }
+        return false;
+    }
+
+    /// Press and release: two reports, one frame apart
+    bool tap(Chord chord) {
+        if (!press(chord)) return false;
+        release(chord);
+        return true;
+    }
+
+    // ── Consumer ──
+
+    /// Press and release a media key; @return false if the queue is full
+    bool consumer(uint16_t usage) {
+        if (consumerCount_ + 2 > Depth) return false;
+        pushConsumer(usage, true);
+        pushConsumer(usage, false);
+        return true;
+    }
+
+    // ── Sending ──
+
+    /**
+     * @brief Send what is due in @p frame
+     * @return true while reports are still pending
+     */
+    template <typename Port>
+    bool poll(uint32_t frame, Port& port) {
+        if (frame == lastFrame_) return pending();
+        bool sent = false;
+        if (count_ > 0) {
+            uint8_t keys[6];
+            uint8_t modifiers = queue_[head_].toReport(keys);
+            if (port.sendKeyboard(modifiers, keys)) {
+                sent_ = queue_[head_];
+                head_ = static_cast<uint8_t>((head_ + 1) % Depth);
+                --count_;
+                ++reports_;
+                sent = true;
+            }
+        }
+        if (consumerCount_ > 0) {
+            const ConsumerEvent& event = consumerQueue_[consumerHead_];
+            if (port.sendConsumer(event.usage, event.pressed)) {
+                consumerHead_ = static_cast<uint8_t>((consumerHead_ + 1) % Depth);
+                --consumerCount_;
+                ++reports_;
+                sent = true;
+            }
+        }
+        if (sent) lastFrame_ = frame;
+        return pending();
+    }
+
+    bool pending() const { return count_ > 0 || consumerCount_ > 0; }
+
+    /// Reports handed to the port so far
+    uint32_t reports() const { return reports_; }
+
+    /// Strokes merged away because the queue was full
+    uint32_t merged() const { return merged_; }
+
+private:
+    struct ConsumerEvent {
+        uint16_t usage;
+        bool pressed;
+    };
+
+    KeySet current() const {
+        KeySet set;
+        for (uint8_t k = 0; k < held_; ++k) {
+            set.words[7] |= chords_[k].modifiers;
+            if (chords_[k].key != key::NONE) set.set(chords_[k].key);
+        }
+        return set;
+    }
+
+    /// Queue the new key state: merged into the pending report where no stroke is lost
+    void update() {
+        KeySet next = current();
+        if (count_ == 0) {
+            if (!(next == sent_)) push(next);
+            return;
+        }
+        uint8_t tail = static_cast<uint8_t>((head_ + count_ - 1) % Depth);
+        const KeySet& before = count_ > 1 ? queue_[(tail + Depth - 1) % Depth] : sent_;
+        if (canMerge(before, queue_[tail], next)) {
+            queue_[tail] = next;
+            return;
+        }
+        if (count_ == Depth) {
+            queue_[tail] = next;
+            ++merged_;
+            return;
+        }
+        push(next);
+    }
+
+    /// A usage toggling twice (before → pending → next) would be invisible to the host
+    static bool canMerge(const KeySet& before, const KeySet& pending, const KeySet& next) {
+        for (uint8_t w = 0; w < 8; ++w) {
+            uint32_t changedTwice = ~(before.words[w] ^ next.words[w]) & (pending.words[w] ^ before.words[w]);
+            if (changedTwice) return false;
+        }
+        return true;
+    }
+
+    void push(const KeySet& set) {
+        queue_[(head_ + count_) % Depth] = set;
+        ++count_;
+    }
+
+    void pushConsumer(uint16_t usage, bool pressed) {
+        consumerQueue_[(consumerHead_ + consumerCount_) % Depth] = {usage, pressed};
+        ++consumerCount_;
+    }
+
+    Chord chords_[MAX_HELD] = {};
+    uint8_t held_ = 0;
+
+    KeySet queue_[Depth];
+    KeySet sent_;
+    uint8_t head_ = 0;
+    uint8_t count_ = 0;
+
+    ConsumerEvent consumerQueue_[Depth] = {};
+    uint8_t consumerHead_ = 0;
+    uint8_t consumerCount_ = 0;
+
+    uint32_t lastFrame_ = UINT32_MAX;
+    uint32_t reports_ = 0;
+    uint32_t merged_ = 0;
+};
+
+}  // namespace minimal::hid
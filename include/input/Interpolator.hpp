@@ -0,0 +1,106 @@
+#pragma once
+
+/**
+ * @file Interpolator.hpp
+ * @brief Sub-tick interpolated encoder position for high-resolution output
+ *
+ * A 24 PPR encoder moves the normalized value in visible steps, even when
+ * sent as 14-bit CC. The interpolator timestamps each tick, estimates the
+ * tick interval (i.e. angular velocity), and glides the output from where
+ * it is to the new tick position over that interval. sample() is called at
+ * the output rate and returns intermediate positions.
+ *
+ * Guarantees:
+ * - monotonic within a glide: output moves toward the latest tick only
+ * - settles exactly on the tick position (the glide ends on it)
+ * - bounded lag: a glide never lasts more than MAX_GLIDE_US
+ *
+ * The glide trails the physical knob by at most one tick interval. It does
+ * not extrapolate past the last tick, because doing so would overshoot and
+ * then have to move backwards when the knob stops.
+ */
+
+#include <cstdint>
+
+namespace minimal::input {
+
+class Interpolator {
+public:
+    /// Longest glide (bounds added latency when turning slowly)
+    static constexpr uint32_t MAX_GLIDE_US = 30000;
+
+    /// Shortest glide (fast spins just track the ticks)
+    static constexpr uint32_t MIN_GLIDE_US = 1000;
+
+    /// Feed a tick: the new normalized position and its timestamp
+    void onTick(float value, uint32_t nowUs) {
+        if (!started_) {
+            output_ = from_ = target_ = value;
+            lastTickUs_ = glideStartUs_ = nowUs;
+            started_ = true;
+            dirty_ = true;
+            return;
+        }
+
+        // EMA of the tick interval, 1/4 weight on the new sample
+        uint32_t interval = nowUs - lastTickUs_;
+        if (interval > MAX_GLIDE_US) interval = MAX_GLIDE_US;
+        intervalUs_ = intervalUs_ ? (intervalUs_ * 3 + interval) / 4 : interval;
+        if (intervalUs_ < MIN_GLIDE_US) intervalUs_ = MIN_GLIDE_US;
+        lastTickUs_ = nowUs;
+
+        from_ = output_;
+        target_ = value;
+        glideStartUs_ = nowUs;
+        dirty_ = true;
+    }
+
+    /// Move straight to @p value, no glide (recall, undo)
+    void jump(float value) {
+        output_ = from_ = target_ = value;
+        started_ = true;
+        dirty_ = true;
+    }
+
+    /**
+     * @brief Advance the glide to @p nowUs
+     * @return true if the output moved since the last sample()
+     */
+    bool sample(uint32_t nowUs) {
+        if (!dirty_) return false;
+        uint32_t elapsed = nowUs - glideStartUs_;
+        float previous = output_;
+        if (elapsed >= intervalUs_) {
+            output_ = target_;
+            dirty_ = false;
+        } else {
+            float t = static_cast<float>(elapsed) / static_cast<float>(intervalUs_);
+            output_ = from_ + (target_ - from_) * t;
+        }
+        return output_ != previous || !dirty_;
+    }
+
+    float value() const { return output_; }
+
+    /// True until the output has settled on the last tick
+    bool gliding() const { return dirty_; }
+
+private:
+    float output_ = 0.0f;
+    float from_ = 0.0f;
+    float target_ = 0.0f;
+    uint32_t lastTickUs_ = 0;
+    uint32_t glideStartUs_ = 0;
+    uint32_t intervalUs_ = 0;
+    bool started_ = false;
+    bool dirty_ = false;
+};
+
+/// Normalized value to 14-bit (0-16383)
+inline uint16_t to14Bit(float value) {
+    if (value <= 0.0f) return 0;
+    if (value >= 1.0f) return 16383;
+    return static_cast<uint16_t>(value * 16383.0f + 0.5f);
+}
+
+}  // namespace minimal::input
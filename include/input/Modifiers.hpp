@@ -0,0 +1,57 @@
+#pragma once
+
+/**
+ * @file Modifiers.hpp
+ * @brief Held-modifier bitmask shared by bindings
+ *
+ * A modifier button sets its bit on press and clears it on release; any
+ * stage that cares about it does a single bit test, instead of every
+ * binding carrying its own .when() lambda.
+ *
+ * @code
+ * Modifiers mods;
+ * onButton(shift).press().then(all(mods.holds(FINE), otherAction));
+ * onButton(shift).release().then(all(mods.releases(FINE), otherAction));
+ * if (mods.test(FINE)) { ... }
+ * @endcode
+ */
+
+#include <cstdint>
+#include <utility>
+
+namespace minimal::input {
+
+class Modifiers {
+public:
+    /// Callable that sets or clears one modifier bit
+    struct Setter {
+        Modifiers* mods;
+        uint32_t mask;
+        bool held;
+
+        void operator()() const {
+            if (held) {
+                mods->bits_ |= mask;
+            } else {
+                mods->bits_ &= ~mask;
+            }
+        }
+    };
+
+    Setter holds(uint32_t mask) { return {this, mask, true}; }
+    Setter releases(uint32_t mask) { return {this, mask, false}; }
+
+    bool test(uint32_t mask) const { return (bits_ & mask) != 0; }
+    uint32_t bits() const { return bits_; }
+
+private:
+    volatile uint32_t bits_ = 0;
+};
+
+/// Run several no-argument callables in order, as one binding callback
+template <typename... Fns>
+auto all(Fns... fns) {
+    return [fns...]() { (fns(), ...); };
+}
+
+}  // namespace minimal::input
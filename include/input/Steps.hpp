@@ -0,0 +1,108 @@
+#pragma once
+
+/**
+ * @file Steps.hpp
+ * @brief Discrete-step mapping for encoders driving enumerated parameters
+ *
+ * turn() reports a normalized float on every tick. For an enum (waveform,
+ * filter type) only the step index matters. steps<N>() wraps a handler so
+ * it runs only when the step index changes:
+ *
+ * @code
+ * onEncoder(id).turn().then(minimal::input::steps<4>([this](uint8_t step) {
+ *     midi().sendCC(ch, cc, minimal::input::STEP_CC<4>[step]);
+ * }));
+ * @endcode
+ *
+ * Detent mapping: by default the range is split into N equal zones. A zone
+ * boundary must be crossed by `hysteresis` (fraction of a zone) before the
+ * step changes, so hovering on a boundary does not chatter.
+ *
+ * Wrap-around: with wrap(turns) the range holds N × turns zones and the
+ * step index is taken modulo N, so one sweep cycles the enum `turns` times
+ * (the encoder value itself is clamped to 0-1, so it cannot wrap past the
+ * end stops).
+ */
+
+#include <array>
+#include <cstdint>
+#include <utility>
+
+namespace minimal::input {
+
+/// CC value for each of N steps, spread evenly over 0-127 (compile time)
+template <uint8_t N>
+constexpr std::array<uint8_t, N> makeStepCCTable() {
+    static_assert(N >= 2, "need at least two steps");
+    std::array<uint8_t, N> table{};
+    for (uint8_t i = 0; i < N; ++i) {
+        table[i] = static_cast<uint8_t>((i * 127u + (N - 1) / 2) / (N - 1));
+    }
+    return table;
+}
+
+template <uint8_t N>
+inline constexpr std::array<uint8_t, N> STEP_CC = makeStepCCTable<N>();
+
+/// Maps a normalized value to a step index, reporting only changes
+template <uint8_t N>
+class StepMapper {
+    static_assert(N >= 2, "need at least two steps");
+
+public:
+    constexpr StepMapper() = default;
+
+    constexpr StepMapper& hysteresis(float fractionOfZone) {
+        hysteresis_ = fractionOfZone;
+        return *this;
+    }
+
+    constexpr StepMapper& wrap(uint8_t turns) {
+        zones_ = static_cast<uint16_t>(N * (turns ? turns : 1));
+        return *this;
+    }
+
+    /**
+     * @brief Feed a new normalized value
+     * @return true if the step index changed (read it with step())
+     */
+    bool update(float value) {
+        float position = value * static_cast<float>(zones_);
+        if (hasZone_) {
+            float low = static_cast<float>(zone_) - hysteresis_;
+            float high = static_cast<float>(zone_ + 1) + hysteresis_;
+            if (position >= low && position < high) return false;
+        }
+        int32_t zone = static_cast<int32_t>(position);
+        if (zone < 0) zone = 0;
+        if (zone >= zones_) zone = zones_ - 1;
+        hasZone_ = true;
+        zone_ = static_cast<uint16_t>(zone);
+
+        uint8_t step = static_cast<uint8_t>(zone_ % N);
+        if (step == step_ && hasStep_) return false;
+        step_ = step;
+        hasStep_ = true;
+        return true;
+    }
+
+    uint8_t step() const { return step_; }
+
+private:
+    float hysteresis_ = 0.25f;
+    uint16_t zones_ = N;
+    uint16_t zone_ = 0;
+    uint8_t step_ = 0;
+    bool hasZone_ = false;
+    bool hasStep_ = false;
+};
+
+/// Wrap a `void(uint8_t step)` handler into a `void(float)` turn handler
+template <uint8_t N, typename Fn>
+auto steps(Fn fn, StepMapper<N> mapper = {}) {
+    return [mapper, fn = std::move(fn)](float value) mutable {
+        if (mapper.update(value)) fn(mapper.step());
+    };
+}
+
+}  // namespace minimal::input
@@ -0,0 +1,342 @@
+#pragma once
+
+/**
+ * @file Stream.hpp
+ * @brief Composable, fused operators for binding callbacks
+ *
+ * Builds a single callable for .then() out of small stages. Every stage's
+ * state lives inline in one object per binding, and the chain is resolved
+ * at compile time, so the cost per event is the same as the hand-written
+ * lambda.
+ *
+ * @code
+ * onEncoder(id).turn().then(
+ *     stream<float>()
+ *         .quantize<127>()       // float 0-1 → uint8_t 0-127
+ *         .changed()             // drop repeats
+ *         .then([this](uint8_t v) { midi().sendCC(ch, cc, v); }));
+ * @endcode
+ *
+ * Operators:
+ * - quantize<Max>() : normalized float → integer 0..Max (rounded, clamped)
+ * - changed()       : pass only values different from the last passed one
+ * - throttle(us)    : pass at most one value per interval; the last value
+ *                     suppressed is kept and emitted by poll()
+ * - map(fn)         : transform the value (type may change)
+ * - fine(mods, mask, factor[, &pos]) : relative position, scaled by
+ *                     factor while a modifier bit is held
+ * - relative(pos)   : relative position kept in an external float (for
+ *                     state restored at boot: no jump on the first turn)
+ * - delta()         : signed movement per event, for relative protocols
+ *
+ * .then() copies the pipeline into the callable. A pipeline that uses
+ * throttle() holds its trailing value (the end of a sweep) until poll()
+ * emits it, and a copy handed to a binding could never be polled. So such
+ * a Fused cannot be copied, and binding it directly does not compile. Keep
+ * it as a member, forward events to it, and poll it from tick():
+ *
+ * @code
+ * struct SendCutoff {
+ *     MyContext* self;
+ *     void operator()(uint8_t v) const { self->sendCutoff(v); }
+ * };
+ * decltype(stream<float>().quantize<127>().throttle(2000).then(SendCutoff{})) cutoff_ =
+ *     stream<float>().quantize<127>().throttle(2000).then(SendCutoff{this});
+ *
+ * onEncoder(id).turn().then([this](float v) { cutoff_(v); wake(); });
+ * void tick() { if (cutoff_.poll()) wake(); }  // re-arm while a value is held
+ * @endcode
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include <Arduino.h>
+
+#include "input/Modifiers.hpp"
+
+namespace minimal::input {
+
+namespace stage {
+
+/**
+ * Relative position driven by input deltas, scaled while a modifier bit is
+ * held. Switching modes never jumps. The position can live outside the
+ * stage (e.g. restored from flash at boot): the first event only latches
+ * the input as reference and leaves that position untouched.
+ *
+ * At an end stop the input stops moving; further events there keep moving
+ * the position toward that end by the last step size instead of snapping.
+ */
+struct Fine {
+    const Modifiers* mods;
+    uint32_t mask;
+    float factor;
+    float* external;
+    float local = 0.0f;
+    float last = 0.0f;
+    float step = 0.0f;
+    bool primed = false;
+
+    float operator()(float v, bool&) {
+        float& position = external ? *external : local;
+        if (!primed) {
+            if (!external) position = v;
+            last = v;
+            primed = true;
+            return position;
+        }
+        float delta = v - last;
+        last = v;
+        if (delta != 0.0f) {
+            step = delta < 0.0f ? -delta : delta;
+        } else if (v <= 0.0f) {
+            delta = -step;
+        } else if (v >= 1.0f) {
+            delta = step;
+        }
+        position += mods && mods->test(mask) ? delta * factor : delta;
+        if (position < 0.0f) position = 0.0f;
+        if (position > 1.0f) position = 1.0f;
+        return position;
+    }
+};
+
+/**
+ * Signed movement since the last event (normalized units), for relative
+ * protocols. Keeps moving at the end stops, as Fine does.
+ */
+struct Delta {
+    float last = 0.0f;
+    float step = 0.0f;
+    bool primed = false;
+
+    float operator()(float v, bool& pass) {
+        if (!primed) {
+            last = v;
+            primed = true;
+            pass = false;
+            return 0.0f;
+        }
+        float delta = v - last;
+        last = v;
+        if (delta != 0.0f) {
+            step = delta < 0.0f ? -delta : delta;
+        } else if (v <= 0.0f) {
+            delta = -step;
+        } else if (v >= 1.0f) {
+            delta = step;
+        }
+        pass = delta != 0.0f;
+        return delta;
+    }
+};
+
+template <uint32_t Max>
+struct Quantize {
+    using Out = std::conditional_t<(Max <= 0xFF), uint8_t,
+                                   std::conditional_t<(Max <= 0xFFFF), uint16_t, uint32_t>>;
+
+    Out operator()(float v, bool&) const {
+        if (v <= 0.0f) return 0;
+        if (v >= 1.0f) return static_cast<Out>(Max);
+        return static_cast<Out>(v * static_cast<float>(Max) + 0.5f);
+    }
+};
+
+template <typename T>
+struct Changed {
+    T last{};
+    bool primed = false;
+
+    T operator()(T v, bool& pass) {
+        pass = !primed || v != last;
+        last = v;
+        primed = true;
+        return v;
+    }
+};
+
+template <typename T>
+struct Throttle {
+    using Value = T;
+
+    uint32_t intervalUs;
+    uint32_t lastUs = 0;
+    T pendingValue{};
+    bool primed = false;
+    bool pending = false;
+
+    T operator()(T v, bool& pass) {
+        uint32_t now = micros();
+        pass = !primed || now - lastUs >= intervalUs;
+        if (pass) {
+            lastUs = now;
+            primed = true;
+            pending = false;
+        } else {
+            pendingValue = v;
+            pending = true;
+        }
+        return v;
+    }
+
+    /// Release the trailing value once the interval has elapsed
+    bool takePending(T& out) {
+        if (!pending || micros() - lastUs < intervalUs) return false;
+        pending = false;
+        lastUs = micros();
+        out = pendingValue;
+        return true;
+    }
+};
+
+template <typename Fn>
+struct Map {
+    Fn fn;
+
+    template <typename T>
+    auto operator()(T v, bool&) {
+        return fn(v);
+    }
+};
+
+template <typename S, typename = void>
+struct HasPending : std::false_type {};
+
+template <typename S>
+struct HasPending<S, std::void_t<typename S::Value>> : std::true_type {};
+
+}  // namespace stage
+
+namespace detail {
+
+/// Pipelines that hold values for poll() must stay where they are polled
+template <bool Polled>
+struct CopyPolicy {};
+
+template <>
+struct CopyPolicy<true> {
+    CopyPolicy() = default;
+    CopyPolicy(const CopyPolicy&) = delete;
+    CopyPolicy& operator=(const CopyPolicy&) = delete;
+};
+
+}  // namespace detail
+
+/// The fused callable: stages + final handler, one object per binding
+template <typename In, typename Fn, typename... Stages>
+class Fused : detail::CopyPolicy<(stage::HasPending<Stages>::value || ...)> {
+public:
+    /// True if a stage holds values back: keep the object and poll() it
+    static constexpr bool NEEDS_POLL = (stage::HasPending<Stages>::value || ...);
+
+    Fused(std::tuple<Stages...> stages, Fn fn) : stages_(std::move(stages)), fn_(std::move(fn)) {}
+
+    void operator()(In v) { run<0>(v); }
+
+    /**
+     * @brief Emit trailing values held back by throttle()
+     * @return true while a value is still held back (poll again later)
+     */
+    bool poll() { return pollFrom<0>(); }
+
+private:
+    template <size_t I, typename T>
+    void run(T v) {
+        if constexpr (I == sizeof...(Stages)) {
+            fn_(v);
+        } else {
+            bool pass = true;
+            auto out = std::get<I>(stages_)(v, pass);
+            if (pass) run<I + 1>(out);
+        }
+    }
+
+    template <size_t I>
+    bool pollFrom() {
+        if constexpr (I == sizeof...(Stages)) {
+            return false;
+        } else {
+            using S = std::tuple_element_t<I, std::tuple<Stages...>>;
+            bool held = false;
+            if constexpr (stage::HasPending<S>::value) {
+                auto& s = std::get<I>(stages_);
+                typename S::Value v;
+                if (s.takePending(v)) run<I + 1>(v);
+                held = s.pending;
+            }
+            return pollFrom<I + 1>() || held;
+        }
+    }
+
+    std::tuple<Stages...> stages_;
+    Fn fn_;
+};
+
+/// Pipeline under construction: In = input type, T = current value type
+template <typename In, typename T, typename... Stages>
+class Stream {
+public:
+    explicit Stream(std::tuple<Stages...> stages = {}) : stages_(std::move(stages)) {}
+
+    template <uint32_t Max>
+    auto quantize() const {
+        static_assert(std::is_floating_point_v<T>, "quantize() expects a normalized float");
+        using Q = stage::Quantize<Max>;
+        return append<typename Q::Out>(Q{});
+    }
+
+    auto fine(const Modifiers& mods, uint32_t mask, float factor, float* position = nullptr) const {
+        static_assert(std::is_floating_point_v<T>, "fine() expects a normalized float");
+        return append<float>(stage::Fine{&mods, mask, factor, position});
+    }
+
+    /// Relative position kept in @p position (no modifier scaling)
+    auto relative(float& position) const {
+        static_assert(std::is_floating_point_v<T>, "relative() expects a normalized float");
+        return append<float>(stage::Fine{nullptr, 0, 1.0f, &position});
+    }
+
+    /// Signed movement per event (the first event only latches the reference)
+    auto delta() const {
+        static_assert(std::is_floating_point_v<T>, "delta() expects a normalized float");
+        return append<float>(stage::Delta{});
+    }
+
+    auto changed() const { return append<T>(stage::Changed<T>{}); }
+
+    auto throttle(uint32_t intervalUs) const {
+        return append<T>(stage::Throttle<T>{intervalUs});
+    }
+
+    template <typename Fn>
+    auto map(Fn fn) const {
+        using Out = std::decay_t<decltype(fn(std::declval<T>()))>;
+        return append<Out>(stage::Map<Fn>{std::move(fn)});
+    }
+
+    template <typename Fn>
+    Fused<In, Fn, Stages...> then(Fn fn) const {
+        return Fused<In, Fn, Stages...>(stages_, std::move(fn));
+    }
+
+private:
+    template <typename Out, typename S>
+    Stream<In, Out, Stages..., S> append(S s) const {
+        return Stream<In, Out, Stages..., S>(std::tuple_cat(stages_, std::make_tuple(std::move(s))));
+    }
+
+    std::tuple<Stages...> stages_;
+};
+
+/// Start a pipeline for callbacks receiving @p In
+template <typename In>
+Stream<In, In> stream() {
+    return Stream<In, In>();
+}
+
+}  // namespace minimal::input
@@ -0,0 +1,90 @@
+#pragma once
+
+/**
+ * @file TapArbiter.hpp
+ * @brief Single vs double tap disambiguation with speculative dispatch
+ *
+ * When a button has both a press and a doubleTap action, the press cannot
+ * be confirmed as "single" until the double-tap window has elapsed. The
+ * arbiter lets each binding choose how to pay for that:
+ *
+ * - Wait                : single fires when the window expires (adds up to
+ *                         windowMs of latency, never wrong)
+ * - Speculate           : single fires on the first press; a second tap in
+ *                         the window fires double as well
+ * - SpeculateCompensate : as Speculate, but `compensate` runs before double
+ *                         to undo the speculative single
+ *
+ * Feed it raw press() events and call poll() regularly (Wait mode needs it
+ * to expire the window). State is a few bytes, no allocation.
+ *
+ * @code
+ * TapArbiter tap(TapPolicy::SpeculateCompensate, Config::DOUBLE_TAP_MS,
+ *                {&onSingle, this}, {&onDouble, this}, {&onUndoSingle, this});
+ * onButton(id).press().then([this] { tap.onPress(millis()); });
+ * @endcode
+ */
+
+#include <cstdint>
+
+namespace minimal::input {
+
+enum class TapPolicy : uint8_t { Wait, Speculate, SpeculateCompensate };
+
+/// Plain function + context, same shape as midi::Handler
+struct Action {
+    void (*fn)(void* ctx) = nullptr;
+    void* ctx = nullptr;
+
+    void operator()() const {
+        if (fn) fn(ctx);
+    }
+};
+
+class TapArbiter {
+public:
+    TapArbiter(TapPolicy policy, uint32_t windowMs, Action single, Action doubleTap,
+               Action compensate = {})
+        : single_(single),
+          double_(doubleTap),
+          compensate_(compensate),
+          windowMs_(windowMs),
+          policy_(policy) {}
+
+    void onPress(uint32_t nowMs) {
+        if (pending_ && nowMs - firstPressMs_ <= windowMs_) {
+            pending_ = false;
+            if (policy_ == TapPolicy::SpeculateCompensate) compensate_();
+            double_();
+            return;
+        }
+        pending_ = true;
+        firstPressMs_ = nowMs;
+        if (policy_ != TapPolicy::Wait) single_();
+    }
+
+    /**
+     * @brief Expire the window; in Wait mode this is where single fires
+     * @return true while a tap is still pending (keep polling)
+     */
+    bool poll(uint32_t nowMs) {
+        if (!pending_) return false;
+        if (nowMs - firstPressMs_ <= windowMs_) return true;
+        pending_ = false;
+        if (policy_ == TapPolicy::Wait) single_();
+        return false;
+    }
+
+    TapPolicy policy() const { return policy_; }
+
+private:
+    Action single_;
+    Action double_;
+    Action compensate_;
+    uint32_t firstPressMs_ = 0;
+    uint32_t windowMs_;
+    TapPolicy policy_;
+    bool pending_ = false;
+};
+
+}  // namespace minimal::input
@@ -0,0 +1,326 @@
+#pragma once
+
+/**
+ * @file Log.hpp
+ * @brief Non-blocking log transport for the example
+ *
+ * OC_LOG_* writes straight to USB serial, which stalls when the host reads
+ * slowly and is not safe inside interrupts. MINIMAL_LOG_* formats into a
+ * stack buffer, pushes the text into a lock-free ring and returns. The ring
+ * is drained from loop() with drainToSerial(), which only writes what the
+ * USB serial TX buffer can take without waiting.
+ *
+ * Full ring → message dropped and counted. The count is reported as a
+ * single "[log] N dropped" line once the host catches up. Messages held
+ * back by a rate-limited call site (LogLimit.hpp) are reported the same
+ * way: on the site's next message, or on their own line once it goes quiet.
+ *
+ * Like OC_LOG_*, the macros compile to nothing without -D OC_LOG.
+ *
+ * Usage:
+ * @code
+ * MINIMAL_LOG_DEBUG("Encoder: CC {} = {}", cc, value);  // safe from ISR
+ * ...
+ * void loop() {
+ *     app->update();
+ *     minimal::log::drainToSerial();
+ * }
+ * @endcode
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <type_traits>
+
+#include <Arduino.h>
+
+#include "log/LogRing.hpp"
+
+namespace minimal::log {
+
+/// Ring slots (power of two)
+constexpr size_t RING_SLOTS = 32;
+
+/// Maximum formatted message length, longer messages are truncated
+constexpr size_t TEXT_SIZE = 96;
+
+using Ring = LogRing<RING_SLOTS, TEXT_SIZE>;
+
+/// Shared ring, written by every producer, drained by loop()
+inline Ring g_ring;
+
+// ═══════════════════════════════════════════════════════════════════
+// Formatting ("{}" placeholders, no heap, no printf)
+// ═══════════════════════════════════════════════════════════════════
+
+/// Type-erased format argument
+struct Arg {
+    enum class Kind : uint8_t { Signed, Unsigned, Float, Bool, Char, String };
+
+    Kind kind;
+    union {
+        int32_t i;
+        uint32_t u;
+        float f;
+        const char* s;
+    };
+
+    template <typename T, std::enable_if_t<std::is_integral_v<T>, int> = 0>
+    Arg(T v) {  // NOLINT(google-explicit-constructor)
+        if constexpr (std::is_same_v<T, bool>) {
+            kind = Kind::Bool;
+            u = v ? 1 : 0;
+        } else if constexpr (std::is_same_v<T, char>) {
+            kind = Kind::Char;
+            u = static_cast<uint8_t>(v);
+        } else if constexpr (std::is_signed_v<T>) {
+            kind = Kind::Signed;
+            i = static_cast<int32_t>(v);
+        } else {
+            kind = Kind::Unsigned;
+            u = static_cast<uint32_t>(v);
+        }
+    }
+    template <typename T, std::enable_if_t<std::is_enum_v<T>, int> = 0>
+    Arg(T v) : Arg(static_cast<std::underlying_type_t<T>>(v)) {}  // NOLINT
+    Arg(float v) : kind(Kind::Float), f(v) {}                     // NOLINT
+    Arg(double v) : kind(Kind::Float), f(static_cast<float>(v)) {}  // NOLINT
+    Arg(const char* v) : kind(Kind::String), s(v ? v : "(null)") {}  // NOLINT
+};
+
+namespace detail {
+
+class Writer {
+public:
+    Writer(char* out, size_t size) : out_(out), size_(size) {}
+
+    void put(char c) {
+        if (length_ < size_) out_[length_++] = c;
+    }
+    void put(const char* s) {
+        while (*s) put(*s++);
+    }
+    void putUnsigned(uint32_t v) {
+        char digits[10];
+        uint8_t n = 0;
+        do {
+            digits[n++] = static_cast<char>('0' + v % 10);
+            v /= 10;
+        } while (v);
+        while (n) put(digits[--n]);
+    }
+    void putSigned(int32_t v) {
+        if (v < 0) {
+            put('-');
+            putUnsigned(0u - static_cast<uint32_t>(v));
+        } else {
+            putUnsigned(static_cast<uint32_t>(v));
+        }
+    }
+    /// Fixed 3 decimals, enough for normalized values
+    void putFloat(float v) {
+        if (v != v) return put("nan");
+        if (v < 0) {
+            put('-');
+            v = -v;
+        }
+        if (v >= 4294967295.0f) return put("inf");
+        uint32_t whole = static_cast<uint32_t>(v);
+        uint32_t frac = static_cast<uint32_t>((v - static_cast<float>(whole)) * 1000.0f + 0.5f);
+        if (frac >= 1000) {
+            ++whole;
+            frac -= 1000;
+        }
+        putUnsigned(whole);
+        put('.');
+        put(static_cast<char>('0' + frac / 100));
+        put(static_cast<char>('0' + frac / 10 % 10));
+        put(static_cast<char>('0' + frac % 10));
+    }
+    void put(const Arg& a) {
+        switch (a.kind) {
+            case Arg::Kind::Signed: putSigned(a.i); break;
+            case Arg::Kind::Unsigned: putUnsigned(a.u); break;
+            case Arg::Kind::Float: putFloat(a.f); break;
+            case Arg::Kind::Bool: put(a.u ? "true" : "false"); break;
+            case Arg::Kind::Char: put(static_cast<char>(a.u)); break;
+            case Arg::Kind::String: put(a.s); break;
+        }
+    }
+
+    size_t length() const { return length_; }
+
+private:
+    char* out_;
+    size_t size_;
+    size_t length_ = 0;
+};
+
+}  // namespace detail
+
+/**
+ * @brief Format into a fixed buffer, replacing each "{}" with the next arg
+ * @return Number of bytes written (no terminator)
+ */
+inline size_t formatArgs(char* out, size_t size, const char* fmt, const Arg* args,
+                         size_t argCount) {
+    detail::Writer w(out, size);
+    size_t next = 0;
+    while (*fmt) {
+        if (fmt[0] == '{' && fmt[1] == '}') {
+            if (next < argCount) w.put(args[next++]);
+            fmt += 2;
+        } else {
+            w.put(*fmt++);
+        }
+    }
+    return w.length();
+}
+
+template <typename... Args>
+size_t format(char* out, size_t size, const char* fmt, const Args&... args) {
+    if constexpr (sizeof...(Args) == 0) {
+        return formatArgs(out, size, fmt, nullptr, 0);
+    } else {
+        const Arg packed[] = {Arg(args)...};
+        return formatArgs(out, size, fmt, packed, sizeof...(Args));
+    }
+}
+
+// ═══════════════════════════════════════════════════════════════════
+// Producer / consumer
+// ═══════════════════════════════════════════════════════════════════
+
+/// Format and enqueue a message (ISR-safe, never blocks)
+template <typename... Args>
+void post(Level level, const char* fmt, const Args&... args) {
+    char text[TEXT_SIZE];
+    size_t length = format(text, sizeof(text), fmt, args...);
+    g_ring.push(level, text, length);
+}
+
+/**
+ * Messages a limited call site (LogLimit.hpp) suppressed since its last
+ * message. The count rides on the site's next message. If the site stays
+ * quiet for QUIET_MS instead (the end of an encoder sweep), drainToSerial()
+ * posts it as "(+N suppressed) <site>", so the tail of a burst is not lost.
+ * The site is named by the literal start of its format ("Arp: gate {}" →
+ * "Arp: gate"), or by its source line when the format starts with "{}",
+ * plus "#i" for one index of a RATE_PER site.
+ */
+class SuppressedCount {
+public:
+    static constexpr uint32_t QUIET_MS = 1000;
+
+    void add(uint32_t nowMs) {
+        ++pending_;
+        lastMs_ = nowMs;
+        if (listed_.exchange(true, std::memory_order_relaxed)) return;
+        SuppressedCount* head = head_.load(std::memory_order_relaxed);
+        do {
+            next_ = head;
+        } while (!head_.compare_exchange_weak(head, this, std::memory_order_release,
+                                              std::memory_order_relaxed));
+    }
+
+    /// Pending count, then reset
+    uint32_t take() {
+        uint32_t n = pending_;
+        pending_ = 0;
+        return n;
+    }
+
+    /// Level and name of the site's last message, used for the standalone report
+    void label(Level level, const char* fmt, uint16_t line, int16_t index = -1) {
+        level_ = level;
+        fmt_ = fmt;
+        line_ = line;
+        index_ = index;
+    }
+
+    /// Post a report for every site quiet for QUIET_MS with a pending count
+    static void reportQuiet(uint32_t nowMs) {
+        for (SuppressedCount* s = head_.load(std::memory_order_acquire); s; s = s->next_) {
+            if (s->pending_ == 0 || nowMs - s->lastMs_ < QUIET_MS) continue;
+            char name[32];
+            s->name(name, sizeof(name));
+            post(s->level_, "(+{} suppressed) {}", s->take(), name);
+        }
+    }
+
+private:
+    inline static std::atomic<SuppressedCount*> head_{nullptr};
+
+    /// Format text up to the first placeholder (or "line N"), then " #index"; NUL-terminated
+    void name(char* out, size_t size) const {
+        size_t length = 0;
+        while (fmt_[length] && !(fmt_[length] == '{' && fmt_[length + 1] == '}') &&
+               length < size - 1) {
+            out[length] = fmt_[length];
+            ++length;
+        }
+        while (length > 0 && (out[length - 1] == ' ' || out[length - 1] == ':' ||
+                              out[length - 1] == '=')) {
+            --length;
+        }
+        if (length == 0) length = format(out, size - 1, "line {}", line_);
+        if (index_ >= 0) length += format(out + length, size - 1 - length, " #{}", index_);
+        out[length] = '\0';
+    }
+
+    SuppressedCount* next_ = nullptr;
+    const char* fmt_ = "";
+    uint32_t pending_ = 0;
+    uint32_t lastMs_ = 0;
+    uint16_t line_ = 0;
+    int16_t index_ = -1;
+    Level level_ = Level::Debug;
+    std::atomic<bool> listed_{false};
+};
+
+/**
+ * @brief Write queued messages to USB serial without blocking
+ *
+ * Call from loop(). Stops as soon as the TX buffer cannot take the next
+ * whole line; the remaining records stay queued.
+ */
+inline void drainToSerial() {
+#ifdef OC_LOG
+    static uint32_t reportedDrops = 0;
+
+    SuppressedCount::reportQuiet(millis());
+
+    g_ring.drain([](const Ring::Record& r) {
+        const char* prefix = r.level == Level::Debug ? "[DEBUG] " : "[INFO] ";
+        size_t prefixLength = r.level == Level::Debug ? 8 : 7;
+        if (Serial.availableForWrite() < static_cast<int>(prefixLength + r.length + 1)) {
+            return false;
+        }
+        Serial.write(reinterpret_cast<const uint8_t*>(prefix), prefixLength);
+        Serial.write(reinterpret_cast<const uint8_t*>(r.text), r.length);
+        Serial.write(reinterpret_cast<const uint8_t*>("\n"), 1);
+        return true;
+    });
+
+    uint32_t dropped = g_ring.dropped();
+    if (dropped != reportedDrops) {
+        char line[32];
+        size_t length = format(line, sizeof(line), "[log] {} dropped\n", dropped - reportedDrops);
+        if (Serial.availableForWrite() >= static_cast<int>(length)) {
+            Serial.write(reinterpret_cast<const uint8_t*>(line), length);
+            reportedDrops = dropped;
+        }
+    }
+#endif
+}
+
+}  // namespace minimal::log
+
+#ifdef OC_LOG
+#define MINIMAL_LOG_INFO(...) ::minimal::log::post(::minimal::log::Level::Info, __VA_ARGS__)
+#define MINIMAL_LOG_DEBUG(...) ::minimal::log::post(::minimal::log::Level::Debug, __VA_ARGS__)
+#else
+#define MINIMAL_LOG_INFO(...) ((void)0)
+#define MINIMAL_LOG_DEBUG(...) ((void)0)
+#endif
@@ -0,0 +1,136 @@
+#pragma once
+
+/**
+ * @file LogLimit.hpp
+ * @brief Per-call-site rate limiting and sampling for MINIMAL_LOG_*
+ *
+ * Each limited macro owns a static SiteLimit, so state is per call site and
+ * costs no allocation. A message that passes after others were suppressed
+ * carries a " (+N suppressed)" suffix. When no message passes afterwards
+ * (the end of a burst), drainToSerial() reports the count on its own line
+ * once the site has been quiet for a second, so nothing disappears silently:
+ * "(+N suppressed) Arp: gate", "(+N suppressed) line 355 #2" for index 2 of
+ * a RATE_PER site whose format starts with "{}" (see SuppressedCount).
+ *
+ * Policies:
+ * - EVERY_N(n, ...)      : 1st, (n+1)th, (2n+1)th... call
+ * - RATE(perSec, ...)    : at most perSec messages per 1 s window
+ * - ON_CHANGE(key, ...)  : only when key differs from the previous call
+ * - RATE_PER(index, count, perSec, ...) : RATE with one limit per index
+ *                          (0..count-1), for a call site shared by several
+ *                          controls, e.g. one lambda bound to every encoder
+ *
+ * Usage:
+ * @code
+ * MINIMAL_LOG_DEBUG_RATE(10, "Encoder: CC {} = {}", cc, value);
+ * MINIMAL_LOG_DEBUG_ON_CHANGE(state, "Mode: {}", state);
+ * MINIMAL_LOG_DEBUG_RATE_PER(i, 4, 10, "Encoder {} = {}", i, value);  // 10/s per encoder
+ * @endcode
+ *
+ * SiteLimit is not synchronized. A site shared by an ISR and the main loop
+ * may miscount a suppressed message, never more.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include <Arduino.h>
+
+#include "log/Log.hpp"
+
+namespace minimal::log {
+
+/// State for one limited log call site
+class SiteLimit : public SuppressedCount {
+public:
+    bool everyN(uint32_t n) {
+        bool pass = count_ == 0;
+        if (++count_ >= n) count_ = 0;
+        return record(pass);
+    }
+
+    bool perSecond(uint32_t maxCount, uint32_t nowMs) {
+        if (nowMs - windowStartMs_ >= 1000) {
+            windowStartMs_ = nowMs;
+            count_ = 0;
+        }
+        bool pass = count_ < maxCount;
+        if (pass) ++count_;
+        return record(pass);
+    }
+
+    bool onChange(int32_t key) {
+        bool pass = !hasKey_ || key != lastKey_;
+        lastKey_ = key;
+        hasKey_ = true;
+        return record(pass);
+    }
+
+private:
+    bool record(bool pass) {
+        if (!pass) add(millis());
+        return pass;
+    }
+
+    uint32_t count_ = 0;
+    uint32_t windowStartMs_ = 0;
+    int32_t lastKey_ = 0;
+    bool hasKey_ = false;
+};
+
+/// Format, append the suppressed summary if any, and enqueue
+template <typename... Args>
+void postLimited(Level level, SiteLimit& site, uint16_t line, int16_t index, const char* fmt,
+                 const Args&... args) {
+    char text[TEXT_SIZE];
+    size_t length = format(text, sizeof(text), fmt, args...);
+    site.label(level, fmt, line, index);
+    uint32_t suppressed = site.take();
+    if (suppressed) {
+        length += format(text + length, sizeof(text) - length, " (+{} suppressed)", suppressed);
+    }
+    g_ring.push(level, text, length);
+}
+
+}  // namespace minimal::log
+
+#ifdef OC_LOG
+#define MINIMAL_LOG_LIMITED_(level, test, ...)                                                \
+    do {                                                                                      \
+        static ::minimal::log::SiteLimit minimalLogSite_;                                     \
+        if (minimalLogSite_.test) {                                                           \
+            ::minimal::log::postLimited(::minimal::log::Level::level, minimalLogSite_,         \
+                                        __LINE__, -1, __VA_ARGS__);                           \
+        }                                                                                     \
+    } while (0)
+#define MINIMAL_LOG_LIMITED_PER_(level, index, count, test, ...)                              \
+    do {                                                                                      \
+        static ::minimal::log::SiteLimit minimalLogSites_[count];                             \
+        size_t minimalLogIndex_ = static_cast<size_t>(index);                                 \
+        if (minimalLogIndex_ >= (count)) minimalLogIndex_ = (count) - 1;                      \
+        auto& minimalLogSite_ = minimalLogSites_[minimalLogIndex_];                           \
+        if (minimalLogSite_.test) {                                                           \
+            ::minimal::log::postLimited(::minimal::log::Level::level, minimalLogSite_,         \
+                                        __LINE__, static_cast<int16_t>(minimalLogIndex_),      \
+                                        __VA_ARGS__);                                         \
+        }                                                                                     \
+    } while (0)
+#else
+#define MINIMAL_LOG_LIMITED_(level, test, ...) ((void)0)
+#define MINIMAL_LOG_LIMITED_PER_(level, index, count, test, ...) ((void)0)
+#endif
+
+#define MINIMAL_LOG_INFO_EVERY_N(n, ...) MINIMAL_LOG_LIMITED_(Info, everyN(n), __VA_ARGS__)
+#define MINIMAL_LOG_DEBUG_EVERY_N(n, ...) MINIMAL_LOG_LIMITED_(Debug, everyN(n), __VA_ARGS__)
+#define MINIMAL_LOG_INFO_RATE(perSec, ...) \
+    MINIMAL_LOG_LIMITED_(Info, perSecond(perSec, millis()), __VA_ARGS__)
+#define MINIMAL_LOG_DEBUG_RATE(perSec, ...) \
+    MINIMAL_LOG_LIMITED_(Debug, perSecond(perSec, millis()), __VA_ARGS__)
+#define MINIMAL_LOG_INFO_RATE_PER(index, count, perSec, ...) \
+    MINIMAL_LOG_LIMITED_PER_(Info, index, count, perSecond(perSec, millis()), __VA_ARGS__)
+#define MINIMAL_LOG_DEBUG_RATE_PER(index, count, perSec, ...) \
+    MINIMAL_LOG_LIMITED_PER_(Debug, index, count, perSecond(perSec, millis()), __VA_ARGS__)
+#define MINIMAL_LOG_INFO_ON_CHANGE(key, ...) \
+    MINIMAL_LOG_LIMITED_(Info, onChange(static_cast<int32_t>(key)), __VA_ARGS__)
+#define MINIMAL_LOG_DEBUG_ON_CHANGE(key, ...) \
+    MINIMAL_LOG_LIMITED_(Debug, onChange(static_cast<int32_t>(key)), __VA_ARGS__)
@@ -0,0 +1,120 @@
+#pragma once
+
+/**
+ * @file LogRing.hpp
+ * @brief Lock-free multi-producer / single-consumer ring of log records
+ *
+ * Producers (main loop and interrupt handlers) claim a slot with a single
+ * compare-and-swap, copy the formatted text, then publish the slot. They
+ * never wait: when the ring is full the message is dropped and counted.
+ *
+ * The single consumer (loop idle time) peeks the oldest record, hands it to
+ * a sink, and only releases the slot when the sink accepted it. A sink that
+ * has no room leaves the record in place for the next drain.
+ *
+ * Sequence scheme: each slot carries a sequence number. A slot is free for
+ * position `pos` when `seq == pos`, and readable when `seq == pos + 1`.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <atomic>
+
+namespace minimal::log {
+
+enum class Level : uint8_t { Debug = 0, Info = 1 };
+
+template <size_t Capacity, size_t TextSize>
+class LogRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "Capacity must be a power of two");
+    static_assert(TextSize <= 0xFFFF, "TextSize must fit in uint16_t");
+
+public:
+    struct Record {
+        Level level;
+        uint16_t length;
+        char text[TextSize];
+    };
+
+    LogRing() {
+        for (size_t i = 0; i < Capacity; ++i) {
+            slots_[i].seq.store(static_cast<uint32_t>(i), std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Copy a message into the ring (ISR-safe, never blocks)
+     * @return false if the ring was full and the message was dropped
+     */
+    bool push(Level level, const char* text, size_t length) {
+        uint32_t pos = head_.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots_[pos & MASK];
+            uint32_t seq = slot.seq.load(std::memory_order_acquire);
+            int32_t diff = static_cast<int32_t>(seq - pos);
+            if (diff == 0) {
+                if (head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    if (length > TextSize) length = TextSize;
+                    slot.record.level = level;
+                    slot.record.length = static_cast<uint16_t>(length);
+                    std::memcpy(slot.record.text, text, length);
+                    slot.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            } else {
+                pos = head_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Hand published records to a sink, oldest first
+     *
+     * The sink is called as `bool sink(const Record&)` and returns false when
+     * it cannot take the record right now; draining stops there.
+     *
+     * Must only be called from one context (the main loop).
+     * @return Number of records consumed
+     */
+    template <typename Sink>
+    size_t drain(Sink&& sink, size_t maxRecords = Capacity) {
+        size_t count = 0;
+        while (count < maxRecords) {
+            Slot& slot = slots_[tail_ & MASK];
+            if (slot.seq.load(std::memory_order_acquire) != tail_ + 1) break;
+            if (!sink(slot.record)) break;
+            slot.seq.store(tail_ + Capacity, std::memory_order_release);
+            ++tail_;
+            ++count;
+        }
+        return count;
+    }
+
+    /// Records queued and not drained yet (consumer side: call from the main loop)
+    size_t pending() const { return head_.load(std::memory_order_relaxed) - tail_; }
+
+    /// Total messages dropped because the ring was full
+    uint32_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    static constexpr uint32_t MASK = Capacity - 1;
+
+    struct Slot {
+        std::atomic<uint32_t> seq;
+        Record record;
+    };
+
+    Slot slots_[Capacity];
+    std::atomic<uint32_t> head_{0};
+    std::atomic<uint32_t> dropped_{0};
+    uint32_t tail_ = 0;
+};
+
+}  // namespace minimal::log
@@ -0,0 +1,231 @@
+#pragma once
+
+/**
+ * @file Feedback.hpp
+ * @brief MCU host → surface feedback parsed into a compact state
+ *
+ * Every message is a constant-time store: a ring CC or meter is one byte,
+ * an LED note one bit, an LCD write a copy of its characters. A DAW sends
+ * meters for every strip several times per 100 ms while playing; parsing
+ * them costs about as much as the dispatcher lookup that delivers them.
+ *
+ * What changed since the last takeChanges() is kept as a bitmask, so a
+ * display or LED driver redraws only those strips:
+ *   bits 0-7   V-Pot ring of strip n
+ *   bits 8-15  meter (or overload flag) of strip n
+ *   bits 16-23 LCD cell of strip n (7 characters, both rows)
+ *   bit 24     a button LED
+ *
+ * Meters fall by one segment per METER_DECAY_MS period in which the host
+ * did not refresh them (transport stopped): call decayMeters() from a tick.
+ *
+ * State is about 170 bytes for all 8 strips.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "mcu/Protocol.hpp"
+
+namespace minimal::mcu {
+
+/// V-Pot LED ring modes (ring CC bits 4-5)
+enum class RingMode : uint8_t { Dot, BoostCut, Wrap, Spread };
+
+class Feedback {
+public:
+    static constexpr uint8_t LCD_COLUMNS = 56;
+    static constexpr uint8_t LCD_ROWS = 2;
+    static constexpr uint8_t LCD_CELL = LCD_COLUMNS / STRIPS;  ///< characters per strip
+
+    /// Meter fall time per segment without host refresh
+    static constexpr uint32_t METER_DECAY_MS = 300;
+
+    static constexpr uint32_t CHANGED_RING = 1u << 0;
+    static constexpr uint32_t CHANGED_METER = 1u << 8;
+    static constexpr uint32_t CHANGED_LCD = 1u << 16;
+    static constexpr uint32_t CHANGED_LED = 1u << 24;
+
+    Feedback() {
+        memset(lcd_, ' ', sizeof(lcd_));
+        for (auto& row : lcd_) row[LCD_COLUMNS] = '\0';
+    }
+
+    // ── Input ──
+
+    /**
+     * @brief Channel message from the host
+     * @return false if it is not MCU feedback
+     */
+    bool onChannelMessage(uint8_t status, uint8_t data1, uint8_t data2) {
+        if ((status & 0x0F) != CHANNEL) return false;
+        switch (status & 0xF0) {
+            case 0xB0:
+                if (data1 < RING_CC || data1 >= RING_CC + STRIPS) return false;
+                onRing(static_cast<uint8_t>(data1 - RING_CC), data2);
+                return true;
+            case 0xD0:
+                onMeter(data1);
+                return true;
+            case 0x90:
+                onLed(data1, data2);
+                return true;
+            case 0x80:
+                onLed(data1, 0);
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    /**
+     * @brief SysEx from the host, with or without the F0 / F7 framing
+     * @return false if it is not an MCU LCD write
+     */
+    bool onSysEx(const uint8_t* data, size_t length) {
+        if (length > 0 && data[0] == 0xF0) {
+            ++data;
+            --length;
+        }
+        if (length > 0 && data[length - 1] == 0xF7) --length;
+        constexpr size_t HEADER = sizeof(SYSEX_HEADER);
+        if (length < HEADER + 2) return false;
+        if (memcmp(data, SYSEX_HEADER, HEADER - 1) != 0) return false;
+        if (data[HEADER - 1] != SYSEX_HEADER[HEADER - 1] && data[HEADER - 1] != SYSEX_MODEL_XT) {
+            return false;
+        }
+        if (data[HEADER] != SYSEX_LCD) return false;
+        writeLcd(data[HEADER + 1], data + HEADER + 2, length - HEADER - 2);
+        return true;
+    }
+
+    /// Let meters fall while the host is not refreshing them
+    void decayMeters(uint32_t nowMs) {
+        if (nowMs - lastDecayMs_ < METER_DECAY_MS) return;
+        lastDecayMs_ = nowMs;
+        uint8_t refreshed = refreshed_;
+        refreshed_ = 0;
+        for (uint8_t s = 0; s < STRIPS; ++s) {
+            if (meter_[s] == 0 || ((refreshed >> s) & 1u)) continue;
+            --meter_[s];
+            changed_ |= CHANGED_METER << s;
+        }
+    }
+
+    // ── State ──
+
+    uint8_t ringPosition(uint8_t strip) const { return ring_[strip] & 0x0F; }
+    RingMode ringMode(uint8_t strip) const { return static_cast<RingMode>((ring_[strip] >> 4) & 0x03); }
+    bool ringCenter(uint8_t strip) const { return ring_[strip] & 0x40; }
+
+    /**
+     * @brief The 11 ring LEDs of a strip (bit 0 = leftmost)
+     *
+     * Position 0 is off, 1-11 select an LED; the mode decides what else
+     * lights: boost/cut fills from the center, wrap from the left, spread
+     * widens symmetrically around the center.
+     */
+    uint16_t ringLeds(uint8_t strip) const {
+        uint8_t position = ringPosition(strip);
+        if (position == 0 || position > 11) return 0;
+        uint8_t led = static_cast<uint8_t>(position - 1);
+        switch (ringMode(strip)) {
+            case RingMode::Dot:
+                return static_cast<uint16_t>(1u << led);
+            case RingMode::BoostCut:
+                return led >= 5 ? span(5, led) : span(led, 5);
+            case RingMode::Wrap:
+                return span(0, led);
+            case RingMode::Spread: {
+                uint8_t width = position > 6 ? 5 : static_cast<uint8_t>(position - 1);
+                return span(static_cast<uint8_t>(5 - width), static_cast<uint8_t>(5 + width));
+            }
+        }
+        return 0;
+    }
+
+    /// Meter level 0-12
+    uint8_t meter(uint8_t strip) const { return meter_[strip]; }
+    bool overload(uint8_t strip) const { return (overload_ >> strip) & 1u; }
+
+    bool led(uint8_t note) const { return (ledOn_[(note & 0x7F) >> 5] >> (note & 31)) & 1u; }
+    bool ledBlinking(uint8_t note) const { return (ledBlink_[(note & 0x7F) >> 5] >> (note & 31)) & 1u; }
+
+    /// One LCD row (0 top, 1 bottom), NUL-terminated
+    const char* lcd(uint8_t row) const { return lcd_[row & 1]; }
+
+    /// Changed state since the last call (CHANGED_* << strip), cleared
+    uint32_t takeChanges() {
+        uint32_t changed = changed_;
+        changed_ = 0;
+        return changed;
+    }
+
+private:
+    static uint16_t span(uint8_t from, uint8_t to) {
+        return static_cast<uint16_t>(((2u << to) - 1u) & ~((1u << from) - 1u));
+    }
+
+    void onRing(uint8_t strip, uint8_t value) {
+        if (ring_[strip] == value) return;
+        ring_[strip] = value;
+        changed_ |= CHANGED_RING << strip;
+    }
+
+    void onMeter(uint8_t data) {
+        uint8_t strip = (data >> 4) & 0x07;
+        uint8_t level = data & 0x0F;
+        if (level == METER_SET_CLIP || level == METER_CLEAR_CLIP) {
+            uint8_t bit = static_cast<uint8_t>(1u << strip);
+            uint8_t overload = level == METER_SET_CLIP ? (overload_ | bit) : (overload_ & ~bit);
+            if (overload == overload_) return;
+            overload_ = overload;
+        } else {
+            if (level > METER_MAX) return;
+            refreshed_ = static_cast<uint8_t>(refreshed_ | (1u << strip));  // no decay this period
+            if (meter_[strip] == level) return;
+            meter_[strip] = level;
+        }
+        changed_ |= CHANGED_METER << strip;
+    }
+
+    void onLed(uint8_t note, uint8_t velocity) {
+        uint32_t bit = 1u << (note & 31);
+        uint32_t& on = ledOn_[(note & 0x7F) >> 5];
+        uint32_t& blink = ledBlink_[(note & 0x7F) >> 5];
+        uint32_t newOn = velocity ? (on | bit) : (on & ~bit);
+        uint32_t newBlink = velocity == 1 ? (blink | bit) : (blink & ~bit);
+        if (newOn == on && newBlink == blink) return;
+        on = newOn;
+        blink = newBlink;
+        changed_ |= CHANGED_LED;
+    }
+
+    /// Offset 0-55 top row, 56-111 bottom row; writes may span both
+    void writeLcd(uint8_t offset, const uint8_t* text, size_t length) {
+        constexpr size_t CELLS = LCD_COLUMNS * LCD_ROWS;
+        if (offset >= CELLS) return;
+        if (length > CELLS - offset) length = CELLS - offset;
+        for (size_t k = 0; k < length; ++k) {
+            size_t at = offset + k;
+            char c = static_cast<char>(text[k] & 0x7F);
+            char& cell = lcd_[at / LCD_COLUMNS][at % LCD_COLUMNS];
+            if (cell == c) continue;
+            cell = c;
+            changed_ |= CHANGED_LCD << ((at % LCD_COLUMNS) / LCD_CELL);
+        }
+    }
+
+    uint8_t ring_[STRIPS] = {};
+    uint8_t meter_[STRIPS] = {};
+    uint32_t lastDecayMs_ = 0;
+    uint8_t refreshed_ = 0;
+    uint8_t overload_ = 0;
+    uint32_t ledOn_[4] = {};
+    uint32_t ledBlink_[4] = {};
+    char lcd_[LCD_ROWS][LCD_COLUMNS + 1];
+    uint32_t changed_ = 0;
+};
+
+}  // namespace minimal::mcu
@@ -0,0 +1,73 @@
+#pragma once
+
+/**
+ * @file Protocol.hpp
+ * @brief Mackie Control Universal (MCU) message numbers
+ *
+ * The subset a V-Pot / button surface needs. All channel messages are on
+ * MIDI channel 1 (0 here); a surface has 8 strips.
+ *
+ * Surface → host:
+ * - V-Pot turn: CC 0x10 + strip, relative (bits 0-5 ticks, bit 6 = CCW)
+ * - Button: note on, velocity 127 pressed / 0 released
+ *
+ * Host → surface:
+ * - V-Pot LED ring: CC 0x30 + strip ([center: 1][mode: 2][position: 4])
+ * - Meter: channel pressure, data = (strip << 4) | level
+ * - Button LED: note on, velocity 0 off / 1 blink / 127 on
+ * - LCD: SysEx F0 00 00 66 14 12 <offset> <ASCII...> F7 (2 × 56 characters)
+ */
+
+#include <cstdint>
+
+namespace minimal::mcu {
+
+constexpr uint8_t CHANNEL = 0;
+constexpr uint8_t STRIPS = 8;
+
+constexpr uint8_t VPOT_CC = 0x10;   ///< + strip, surface → host
+constexpr uint8_t RING_CC = 0x30;   ///< + strip, host → surface
+
+/// Most ticks one V-Pot message carries
+constexpr uint8_t VPOT_MAX_TICKS = 0x3F;
+
+/// Button notes (LED feedback comes back on the same note)
+namespace note {
+constexpr uint8_t REC_ARM = 0x00;   ///< + strip
+constexpr uint8_t SOLO = 0x08;      ///< + strip
+constexpr uint8_t MUTE = 0x10;      ///< + strip
+constexpr uint8_t SELECT = 0x18;    ///< + strip
+constexpr uint8_t VPOT_PUSH = 0x20; ///< + strip
+constexpr uint8_t BANK_LEFT = 0x2E;
+constexpr uint8_t BANK_RIGHT = 0x2F;
+constexpr uint8_t CHANNEL_LEFT = 0x30;
+constexpr uint8_t CHANNEL_RIGHT = 0x31;
+constexpr uint8_t MARKER = 0x54;
+constexpr uint8_t REWIND = 0x5B;
+constexpr uint8_t FAST_FWD = 0x5C;
+constexpr uint8_t STOP = 0x5D;
+constexpr uint8_t PLAY = 0x5E;
+constexpr uint8_t RECORD = 0x5F;
+}  // namespace note
+
+/// SysEx header after F0: manufacturer 00 00 66, model 14 (MCU) or 15 (XT)
+constexpr uint8_t SYSEX_HEADER[] = {0x00, 0x00, 0x66, 0x14};
+constexpr uint8_t SYSEX_MODEL_XT = 0x15;
+constexpr uint8_t SYSEX_LCD = 0x12;
+
+/// Meter data: 0x0-0xC level, 0xE sets the overload flag, 0xF clears it
+constexpr uint8_t METER_MAX = 0x0C;
+constexpr uint8_t METER_SET_CLIP = 0x0E;
+constexpr uint8_t METER_CLEAR_CLIP = 0x0F;
+
+/// Signed ticks → V-Pot CC value (clamped to ±63, 0 is not a valid message)
+constexpr uint8_t encodeVPot(int ticks) {
+    if (ticks > VPOT_MAX_TICKS) ticks = VPOT_MAX_TICKS;
+    if (ticks < -VPOT_MAX_TICKS) ticks = -VPOT_MAX_TICKS;
+    return ticks < 0 ? static_cast<uint8_t>(0x40 | -ticks) : static_cast<uint8_t>(ticks);
+}
+
+static_assert(encodeVPot(1) == 0x01 && encodeVPot(-1) == 0x41 && encodeVPot(-100) == 0x7F,
+              "V-Pot encoding");
+
+}  // namespace minimal::mcu
@@ -0,0 +1,74 @@
+#pragma once
+
+/**
+ * @file VPot.hpp
+ * @brief Encoder movement → accelerated relative V-Pot ticks
+ *
+ * Input is the signed movement per encoder event in unaccelerated ticks
+ * (stream<float>().delta() × ticks per full range). It is multiplied by an
+ * acceleration that depends on the time since the previous event: slow
+ * turns move one tick per detent for fine positioning, fast spins cover a
+ * pan or send range in one flick.
+ *
+ * Fractions are carried to the next event, so a scale below one tick per
+ * event still moves; a direction change drops the carried fraction.
+ *
+ * @code
+ * VPot vpot;
+ * onEncoder(id).turn().then(stream<float>().delta().then([&](float d) {
+ *     if (int8_t ticks = vpot.ticks(d * 18.0f, millis())) send(VPOT_CC + strip, encodeVPot(ticks));
+ * }));
+ * @endcode
+ */
+
+#include <cstdint>
+
+#include "mcu/Protocol.hpp"
+
+namespace minimal::mcu {
+
+class VPot {
+public:
+    /// Events further apart than this move at 1× (ms)
+    static constexpr uint32_t SLOW_MS = 60;
+
+    /// Events this close (or closer) move at MAX_ACCELERATION (ms)
+    static constexpr uint32_t FAST_MS = 8;
+
+    static constexpr float MAX_ACCELERATION = 6.0f;
+
+    /**
+     * @brief Movement → ticks to send now
+     * @param movement signed movement of this event, in ticks before acceleration
+     * @return signed ticks, 0 if nothing is due (fraction carried)
+     */
+    int8_t ticks(float movement, uint32_t nowMs) {
+        uint32_t elapsed = nowMs - lastMs_;
+        lastMs_ = nowMs;
+        if ((movement < 0.0f) != (carry_ < 0.0f)) carry_ = 0.0f;
+
+        carry_ += movement * acceleration(elapsed);
+        // Toward zero (the fraction keeps its sign); normalized steps are not exact in float
+        int whole = static_cast<int>(carry_ + (carry_ < 0.0f ? -EPSILON : EPSILON));
+        carry_ -= static_cast<float>(whole);
+        if (whole > VPOT_MAX_TICKS) whole = VPOT_MAX_TICKS;
+        if (whole < -VPOT_MAX_TICKS) whole = -VPOT_MAX_TICKS;
+        return static_cast<int8_t>(whole);
+    }
+
+    /// Multiplier for an event @p elapsedMs after the previous one
+    static float acceleration(uint32_t elapsedMs) {
+        if (elapsedMs >= SLOW_MS) return 1.0f;
+        if (elapsedMs <= FAST_MS) return MAX_ACCELERATION;
+        float t = static_cast<float>(SLOW_MS - elapsedMs) / static_cast<float>(SLOW_MS - FAST_MS);
+        return 1.0f + t * t * (MAX_ACCELERATION - 1.0f);
+    }
+
+private:
+    static constexpr float EPSILON = 1e-3f;
+
+    float carry_ = 0.0f;
+    uint32_t lastMs_ = 0;
+};
+
+}  // namespace minimal::mcu
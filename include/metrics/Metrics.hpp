@@ -0,0 +1,160 @@
+#pragma once
+
+/**
+ * @file Metrics.hpp
+ * @brief Zero-allocation registry of named counters, gauges and histograms
+ *
+ * A metric registers itself at construction into an intrusive list, so
+ * declaring a static (or inline static member) is all it takes:
+ *
+ * @code
+ * inline minimal::metrics::Counter s_presses{"button.presses"};
+ * s_presses.inc();                       // one load/add/store
+ *
+ * minimal::metrics::forEach([](const Metric& m) { ... });
+ * @endcode
+ *
+ * Updates are plain (non-atomic) stores: cheap enough for hot paths, and a
+ * metric shared between an ISR and the main loop may lose an increment.
+ * Metrics must have static storage duration; the list is never unlinked.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace minimal::metrics {
+
+enum class Kind : uint8_t { Counter, Gauge, Histogram };
+
+class Metric {
+public:
+    Metric(const Metric&) = delete;
+    Metric& operator=(const Metric&) = delete;
+
+    const char* name() const { return name_; }
+    Kind kind() const { return kind_; }
+    const Metric* next() const { return next_; }
+
+    /// First registered metric (most recently constructed)
+    static const Metric* head() { return head_; }
+
+protected:
+    Metric(const char* name, Kind kind) : name_(name), kind_(kind), next_(head_) { head_ = this; }
+
+private:
+    const char* name_;
+    Kind kind_;
+    const Metric* next_;
+
+    inline static const Metric* head_ = nullptr;
+};
+
+/// Monotonic event count
+class Counter : public Metric {
+public:
+    explicit Counter(const char* name) : Metric(name, Kind::Counter) {}
+
+    void inc() { ++value_; }
+    void add(uint32_t n) { value_ += n; }
+    uint32_t value() const { return value_; }
+
+private:
+    uint32_t value_ = 0;
+};
+
+/// Last sampled value, plus the highest value seen
+class Gauge : public Metric {
+public:
+    explicit Gauge(const char* name) : Metric(name, Kind::Gauge) {}
+
+    void set(int32_t v) {
+        value_ = v;
+        if (!sampled_ || v > max_) max_ = v;
+        sampled_ = true;
+    }
+    int32_t value() const { return value_; }
+
+    /// Highest value set so far (0 before the first set())
+    int32_t max() const { return max_; }
+
+private:
+    int32_t value_ = 0;
+    int32_t max_ = 0;
+    bool sampled_ = false;
+};
+
+/**
+ * @brief Bucketed distribution, storage held by the derived template
+ *
+ * Bucket i counts samples <= bounds[i]; the last bucket is overflow.
+ */
+class HistogramBase : public Metric {
+public:
+    void record(uint32_t v) {
+        size_t i = 0;
+        while (i < boundCount_ && v > bounds_[i]) ++i;
+        ++buckets_[i];
+    }
+
+    size_t bucketCount() const { return boundCount_ + 1; }
+    uint32_t bucket(size_t i) const { return buckets_[i]; }
+    /// Upper bound of bucket i, UINT32_MAX for the overflow bucket
+    uint32_t bound(size_t i) const { return i < boundCount_ ? bounds_[i] : UINT32_MAX; }
+
+protected:
+    HistogramBase(const char* name, const uint32_t* bounds, size_t boundCount, uint32_t* buckets)
+        : Metric(name, Kind::Histogram),
+          bounds_(bounds),
+          boundCount_(boundCount),
+          buckets_(buckets) {}
+
+private:
+    const uint32_t* bounds_;
+    size_t boundCount_;
+    uint32_t* buckets_;
+};
+
+template <size_t N>
+class Histogram : public HistogramBase {
+public:
+    /// @param bounds Ascending bucket upper bounds (must outlive the metric)
+    Histogram(const char* name, const uint32_t (&bounds)[N])
+        : HistogramBase(name, bounds, N, buckets_) {}
+
+private:
+    uint32_t buckets_[N + 1] = {};
+};
+
+// ═══════════════════════════════════════════════════════════════════
+// Enumeration
+// ═══════════════════════════════════════════════════════════════════
+
+template <typename Fn>
+void forEach(Fn&& fn) {
+    for (const Metric* m = Metric::head(); m; m = m->next()) fn(*m);
+}
+
+inline const Metric* find(const char* name) {
+    for (const Metric* m = Metric::head(); m; m = m->next()) {
+        if (std::strcmp(m->name(), name) == 0) return m;
+    }
+    return nullptr;
+}
+
+/// Scalar reading: counter value, gauge value, or histogram sample count
+inline int64_t valueOf(const Metric& m) {
+    switch (m.kind()) {
+        case Kind::Counter: return static_cast<const Counter&>(m).value();
+        case Kind::Gauge: return static_cast<const Gauge&>(m).value();
+        case Kind::Histogram: {
+            const auto& h = static_cast<const HistogramBase&>(m);
+            int64_t total = 0;
+            for (size_t i = 0; i < h.bucketCount(); ++i) total += h.bucket(i);
+            return total;
+        }
+    }
+    return 0;
+}
+
+}  // namespace minimal::metrics
@@ -0,0 +1,138 @@
+#pragma once
+
+/**
+ * @file MetricsReport.hpp
+ * @brief Read out the metrics registry over serial (log) or SysEx
+ *
+ * SysEx layout, one message per metric (all payload bytes 7-bit):
+ *
+ *   F0 7D 4D <kind> <name ascii...> 00 <value: 5 bytes, LSB first> ... F7
+ *
+ * 7D is the non-commercial manufacturer ID, 4D ('M') tags metrics.
+ * Counters and gauges carry one value. Histograms carry the bucket count
+ * followed by one 5-byte value per bucket.
+ *
+ * The log dump writes one line per metric. The registry has more metrics
+ * than the log ring has slots, so logAll() only starts the dump.
+ * logDump.poll(), from loop(), queues further lines while the ring is at
+ * most half full, at the pace drainToSerial() empties it.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include "log/Log.hpp"
+#include "metrics/Metrics.hpp"
+
+namespace minimal::metrics {
+
+constexpr uint8_t SYSEX_MANUFACTURER = 0x7D;
+constexpr uint8_t SYSEX_METRICS_TAG = 0x4D;
+
+/// Largest message: header, 32-char name, 16 histogram buckets
+constexpr size_t SYSEX_MAX_SIZE = 4 + 32 + 1 + 1 + 16 * 5 + 1;
+
+/**
+ * @brief Encode one metric as a SysEx message
+ * @return Message length, 0 if it does not fit in @p capacity
+ */
+inline size_t encodeSysEx(const Metric& m, uint8_t* out, size_t capacity) {
+    size_t n = 0;
+    auto put = [&](uint8_t b) {
+        if (n < capacity) out[n] = b;
+        ++n;
+    };
+    auto put32 = [&](uint32_t v) {
+        for (int i = 0; i < 5; ++i, v >>= 7) put(static_cast<uint8_t>(v & 0x7F));
+    };
+
+    put(0xF0);
+    put(SYSEX_MANUFACTURER);
+    put(SYSEX_METRICS_TAG);
+    put(static_cast<uint8_t>(m.kind()));
+    for (const char* c = m.name(); *c; ++c) put(static_cast<uint8_t>(*c) & 0x7F);
+    put(0x00);
+    switch (m.kind()) {
+        case Kind::Counter: put32(static_cast<const Counter&>(m).value()); break;
+        case Kind::Gauge: put32(static_cast<uint32_t>(static_cast<const Gauge&>(m).value())); break;
+        case Kind::Histogram: {
+            const auto& h = static_cast<const HistogramBase&>(m);
+            put(static_cast<uint8_t>(h.bucketCount()));
+            for (size_t i = 0; i < h.bucketCount(); ++i) put32(h.bucket(i));
+            break;
+        }
+    }
+    put(0xF7);
+    return n <= capacity ? n : 0;
+}
+
+/// Send every metric as one SysEx message each (Midi: anything with sendSysEx)
+template <typename Midi>
+void sendSysEx(Midi& midi) {
+    forEach([&](const Metric& m) {
+        uint8_t buffer[SYSEX_MAX_SIZE];
+        size_t length = encodeSysEx(m, buffer, sizeof(buffer));
+        if (length) midi.sendSysEx(buffer, static_cast<uint16_t>(length));
+    });
+}
+
+/// One log line: "metric loop.us = 1251 [1203 45 3 0 0 0 0]" for a histogram
+inline void logMetric(const Metric& m) {
+    char text[log::TEXT_SIZE];
+    size_t n = 0;
+    switch (m.kind()) {
+        case Kind::Counter:
+            n = log::format(text, sizeof(text), "metric {} = {}", m.name(),
+                            static_cast<const Counter&>(m).value());
+            break;
+        case Kind::Gauge: {
+            const auto& g = static_cast<const Gauge&>(m);
+            n = log::format(text, sizeof(text), "metric {} = {} (max {})", m.name(), g.value(), g.max());
+            break;
+        }
+        case Kind::Histogram: {
+            // Sample count, then each bucket (bounds are in the code and the SysEx dump)
+            const auto& h = static_cast<const HistogramBase&>(m);
+            n = log::format(text, sizeof(text), "metric {} = {} [", m.name(),
+                            static_cast<uint32_t>(valueOf(m)));
+            for (size_t i = 0; i < h.bucketCount(); ++i) {
+                n += log::format(text + n, sizeof(text) - n, i ? " {}" : "{}", h.bucket(i));
+            }
+            n += log::format(text + n, sizeof(text) - n, "]");
+            break;
+        }
+    }
+    log::g_ring.push(log::Level::Info, text, n);
+}
+
+/// Paced log dump of the whole registry (see the file comment)
+class LogDump {
+public:
+    void start() { next_ = Metric::head(); }
+
+    /// Queue lines while the ring has room; @return true while metrics are left
+    bool poll() {
+#ifdef OC_LOG
+        while (next_ && log::g_ring.pending() < log::Ring::capacity() / 2) {
+            logMetric(*next_);
+            next_ = next_->next();
+        }
+        return next_ != nullptr;
+#else
+        return false;
+#endif
+    }
+
+private:
+    const Metric* next_ = nullptr;
+};
+
+inline LogDump logDump;
+
+/// Start a log dump of every metric; loop() continues it with logDump.poll()
+inline void logAll() {
+    logDump.start();
+    logDump.poll();
+}
+
+}  // namespace minimal::metrics
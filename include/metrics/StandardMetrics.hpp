@@ -0,0 +1,48 @@
+#pragma once
+
+/**
+ * @file StandardMetrics.hpp
+ * @brief Metrics every context and the main loop report into
+ *
+ * The framework does not expose its own counters, so the example records
+ * them where events surface: binding callbacks, MIDI sends and loop().
+ */
+
+#include <cstdint>
+
+#include "metrics/Metrics.hpp"
+
+namespace minimal::metrics::standard {
+
+/// Encoder binding callbacks fired
+inline Counter encoderEvents{"encoder.events"};
+
+/// Button binding callbacks fired
+inline Counter buttonEvents{"button.events"};
+
+/// MIDI messages sent
+inline Counter midiOut{"midi.out"};
+
+/// MIDI messages dropped: output queue full during a disconnect or stall
+inline Counter midiOutDropped{"midi.out.dropped"};
+
+/// Host stalls detected on USB-MIDI output
+inline Counter midiOutStalls{"midi.out.stalls"};
+
+/// USB configurations by the host (first enumeration included)
+inline Counter usbReconnects{"usb.connects"};
+
+/// Channel messages received
+inline Counter midiIn{"midi.in"};
+
+/// Channel messages received with no matching binding
+inline Counter midiInDropped{"midi.in.dropped"};
+
+/// Context tick() calls (updates that had work to do, not every update())
+inline Counter contextUpdates{"context.updates"};
+
+/// loop() duration in microseconds
+inline constexpr uint32_t LOOP_US_BOUNDS[] = {10, 50, 100, 250, 500, 1000};
+inline Histogram<6> loopUs{"loop.us", LOOP_US_BOUNDS};
+
+}  // namespace minimal::metrics::standard
@@ -0,0 +1,119 @@
+#pragma once
+
+/**
+ * @file FrameSync.hpp
+ * @brief Phase-align the input scan and MIDI flush to USB (micro)frames
+ *
+ * The host collects IN data once per frame (1 ms full speed, 125 µs
+ * microframe at high speed). Data flushed just after a start-of-frame
+ * waits almost a whole period; data flushed just before it goes out at
+ * once. With a free-running loop the phase is random, which adds up to one
+ * period of latency and as much jitter.
+ *
+ * FrameSync tracks SOF edges from the controller's frame index (USB1_FRINDEX)
+ * against the cycle counter, and lets loop() run its scan leadUs before the
+ * next edge and flush right after:
+ *
+ * @code
+ * sync.waitForSlot();   // spins until leadUs before the next SOF
+ * app->update();        // input scan, binding callbacks write MIDI
+ * sync.flush();         // usbOut.flush() (send_now): ready for this frame
+ * @endcode
+ *
+ * The Teensy core owns the USB interrupt and exposes no SOF callback, so
+ * edges are observed while spinning in waitForSlot(): every wait re-syncs
+ * the phase. leadUs must cover the scan; when it overruns, the next slot
+ * is used (at most one period of waiting).
+ *
+ * flushToSof() records the time from each flush to the next SOF edge
+ * (projected from the last reference edge), i.e. how long output waits for
+ * the host. Free-running, that spreads over the whole period; aligned, it
+ * sits just under leadUs minus the scan time.
+ */
+
+#include <cstdint>
+
+#include <Arduino.h>
+
+#include "metrics/Metrics.hpp"
+#include "midi/OutputQueue.hpp"
+#include "midi/UsbConnection.hpp"
+
+namespace minimal::midi {
+
+class FrameSync {
+public:
+    /// Microframe length; FRINDEX advances once per microframe (8 per FS frame)
+    static constexpr uint32_t MICROFRAME_US = 125;
+
+    explicit FrameSync(uint32_t leadUs) : leadUs_(leadUs) {}
+
+    /// Spin until leadUs before the next SOF edge (returns at once off-target)
+    void waitForSlot() {
+#if defined(__IMXRT1062__)
+        if (!usbConfigured()) return;
+        const uint32_t cyclesPerUs = F_CPU_ACTUAL / 1000000;
+        const uint32_t start = ARM_DWT_CYCCNT;
+        uint32_t previous = start;
+        bool first = true;
+        for (;;) {
+            uint32_t now = ARM_DWT_CYCCNT;
+            // No frames (suspended bus): give up rather than stall the loop
+            if (now - start > MAX_WAIT_US * cyclesPerUs) return;
+            uint32_t index = USB1_FRINDEX & 0x3FFF;
+            if (index != lastIndex_) {
+                // Full speed leaves FRINDEX[2:0] at zero and counts in 8s
+                periodUs_ = ((index | lastIndex_) & 7) == 0 ? 1000 : MICROFRAME_US;
+                lastIndex_ = index;
+                // Only an edge seen between two tight polls is a phase reference
+                if (!first && now - previous < PRECISE_US * cyclesPerUs) {
+                    edgeAt_ = now;
+                    synced_ = true;
+                }
+            }
+            previous = now;
+            first = false;
+            if (!synced_) continue;
+            uint32_t phaseUs = ((now - edgeAt_) / cyclesPerUs) % periodUs_;
+            uint32_t target = periodUs_ > leadUs_ ? periodUs_ - leadUs_ : 0;
+            if (phaseUs >= target && phaseUs < target + SLOT_WINDOW_US) return;
+        }
+#endif
+    }
+
+    /// Hand the pending MIDI packets to the controller now
+    void flush() {
+        usbOut.flush();
+#if defined(__IMXRT1062__)
+        if (!synced_) return;
+        uint32_t phaseUs = ((ARM_DWT_CYCCNT - edgeAt_) / (F_CPU_ACTUAL / 1000000)) % periodUs_;
+        flushToSof_.record(periodUs_ - phaseUs);
+#endif
+    }
+
+    /// Detected frame period in µs (1000 full speed, 125 high speed)
+    uint32_t periodUs() const { return periodUs_; }
+
+    static metrics::HistogramBase& flushToSof() { return flushToSof_; }
+
+private:
+    /// A slot is missed if the loop arrives later than this into it
+    static constexpr uint32_t SLOT_WINDOW_US = 10;
+
+    /// Longest wait: two full-speed frames
+    static constexpr uint32_t MAX_WAIT_US = 2000;
+
+    /// Max gap between the polls bracketing an edge for it to set the phase
+    static constexpr uint32_t PRECISE_US = 2;
+
+    inline static constexpr uint32_t FLUSH_TO_SOF_BOUNDS[] = {10, 25, 50, 125, 250, 500, 1000};
+    inline static metrics::Histogram<7> flushToSof_{"usb.flush_to_sof.us", FLUSH_TO_SOF_BOUNDS};
+
+    uint32_t leadUs_;
+    uint32_t periodUs_ = MICROFRAME_US;
+    uint32_t edgeAt_ = 0;
+    uint32_t lastIndex_ = 0;
+    bool synced_ = false;
+};
+
+}  // namespace minimal::midi
@@ -0,0 +1,232 @@
+#pragma once
+
+/**
+ * @file IncomingDispatcher.hpp
+ * @brief Routes incoming channel messages to bindings in constant time
+ *
+ * Two stages:
+ * 1. Subscription bitset (2 KB): one bit per (type, channel, number) triple.
+ *    Anything not subscribed is dropped with a single bit test, before any
+ *    hashing. A DAW streaming feedback for hundreds of parameters mostly
+ *    hits this path.
+ * 2. Perfect hash (hash-and-displace), rebuilt by rebuild() whenever the
+ *    subscriptions change. Lookup is one mix, one displacement read and one
+ *    key compare, whatever the number of bindings.
+ *
+ * Key layout (14 bits): [type: 3][channel: 4][number: 7]
+ * - number is data1 for notes, poly pressure, CC and program change
+ * - number is 0 for channel pressure and pitch bend
+ *
+ * Usage:
+ * @code
+ * IncomingDispatcher<64> in;
+ * in.subscribe(MessageType::ControlChange, 0, 16, {&onFeedback, this});
+ * in.rebuild();                     // after every batch of subscribe()
+ * in.dispatch(status, data1, data2);
+ * @endcode
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace minimal::midi {
+
+enum class MessageType : uint8_t {
+    NoteOff = 0x8,
+    NoteOn = 0x9,
+    PolyPressure = 0xA,
+    ControlChange = 0xB,
+    ProgramChange = 0xC,
+    ChannelPressure = 0xD,
+    PitchBend = 0xE,
+};
+
+/// Plain function + context, no allocation, no std::function indirection
+struct Handler {
+    void (*fn)(void* ctx, uint8_t channel, uint8_t data1, uint8_t data2) = nullptr;
+    void* ctx = nullptr;
+};
+
+/// One bit per (type, channel, number): 8 × 16 × 128 bits = 2 KB
+class SubscriptionSet {
+public:
+    static constexpr uint16_t key(uint8_t type, uint8_t channel, uint8_t number) {
+        return static_cast<uint16_t>(((type & 0x7) << 11) | ((channel & 0xF) << 7) |
+                                     (number & 0x7F));
+    }
+
+    /// Key of a raw message, UINT16_MAX for non-channel messages
+    static constexpr uint16_t keyOf(uint8_t status, uint8_t data1) {
+        if (status < 0x80 || status >= 0xF0) return UINT16_MAX;
+        uint8_t type = status >> 4;
+        bool numbered = type != 0xD && type != 0xE;
+        return key(type, status & 0x0F, numbered ? data1 : 0);
+    }
+
+    void set(uint16_t k) { words_[k >> 5] |= 1u << (k & 31); }
+    bool test(uint16_t k) const { return (words_[k >> 5] >> (k & 31)) & 1u; }
+    void clear() {
+        for (auto& w : words_) w = 0;
+    }
+
+private:
+    uint32_t words_[(8 * 16 * 128) / 32] = {};
+};
+
+template <size_t MaxBindings>
+class IncomingDispatcher {
+    static_assert(MaxBindings > 0 && MaxBindings < 0xFFFF, "MaxBindings out of range");
+
+    static constexpr size_t nextPow2(size_t v) {
+        size_t p = 1;
+        while (p < v) p <<= 1;
+        return p;
+    }
+
+    /// Load factor <= 0.8, ~4 keys per displacement bucket
+    static constexpr size_t TABLE_SIZE = nextPow2(MaxBindings + MaxBindings / 4 + 1);
+    static constexpr size_t BUCKET_COUNT = TABLE_SIZE >= 4 ? TABLE_SIZE / 4 : 1;
+    static constexpr uint16_t EMPTY = UINT16_MAX;
+    static constexpr uint32_t MAX_SEEDS = 64;
+
+public:
+    IncomingDispatcher() { clearTable(); }
+
+    /**
+     * @brief Add or replace a binding (takes effect at the next rebuild())
+     * @return false if MaxBindings is reached
+     */
+    bool subscribe(MessageType type, uint8_t channel, uint8_t number, Handler handler) {
+        bool numbered = type != MessageType::ChannelPressure && type != MessageType::PitchBend;
+        uint16_t k = SubscriptionSet::key(static_cast<uint8_t>(type), channel, numbered ? number : 0);
+        for (size_t i = 0; i < count_; ++i) {
+            if (keys_[i] == k) {
+                handlers_[i] = handler;
+                return true;
+            }
+        }
+        if (count_ >= MaxBindings) return false;
+        keys_[count_] = k;
+        handlers_[count_] = handler;
+        ++count_;
+        return true;
+    }
+
+    /// Remove every binding (takes effect at the next rebuild())
+    void clear() { count_ = 0; }
+
+    /**
+     * @brief Rebuild the subscription bitset and the perfect hash
+     *
+     * Not real-time: call after bindings change, outside the input path.
+     * @return false if no collision-free seed was found (practically never;
+     *         the dispatcher then routes nothing until the next rebuild)
+     */
+    bool rebuild() {
+        subscribed_.clear();
+        for (uint32_t seed = 1; seed <= MAX_SEEDS; ++seed) {
+            if (tryBuild(seed * 0x9E3779B9u)) {
+                for (size_t i = 0; i < count_; ++i) subscribed_.set(keys_[i]);
+                return true;
+            }
+        }
+        clearTable();
+        return false;
+    }
+
+    /**
+     * @brief Route one channel message
+     * @return true if a binding handled it, false if dropped
+     */
+    bool dispatch(uint8_t status, uint8_t data1, uint8_t data2) const {
+        uint16_t k = SubscriptionSet::keyOf(status, data1);
+        if (k == UINT16_MAX || !subscribed_.test(k)) return false;
+
+        uint32_t h = mix(k, seed_);
+        size_t slot = (h ^ displacement_[(h >> 16) & (BUCKET_COUNT - 1)]) & (TABLE_SIZE - 1);
+        if (slotKey_[slot] != k) return false;
+
+        const Handler& handler = handlers_[slotIndex_[slot]];
+        handler.fn(handler.ctx, status & 0x0F, data1, data2);
+        return true;
+    }
+
+    size_t size() const { return count_; }
+    static constexpr size_t capacity() { return MaxBindings; }
+
+private:
+    static uint32_t mix(uint32_t k, uint32_t seed) {
+        uint32_t x = (k ^ seed) * 0x9E3779B1u;
+        x ^= x >> 15;
+        x *= 0x85EBCA77u;
+        x ^= x >> 13;
+        return x;
+    }
+
+    void clearTable() {
+        for (auto& k : slotKey_) k = EMPTY;
+        for (auto& d : displacement_) d = 0;
+        seed_ = 0;
+    }
+
+    bool tryBuild(uint32_t seed) {
+        clearTable();
+
+        // Bucket keys (counting sort by bucket)
+        uint16_t bucketSize[BUCKET_COUNT] = {};
+        uint16_t bucketStart[BUCKET_COUNT + 1] = {};
+        uint16_t order[MaxBindings];
+        for (size_t i = 0; i < count_; ++i) ++bucketSize[(mix(keys_[i], seed) >> 16) & (BUCKET_COUNT - 1)];
+        for (size_t b = 0; b < BUCKET_COUNT; ++b) bucketStart[b + 1] = bucketStart[b] + bucketSize[b];
+        uint16_t fill[BUCKET_COUNT];
+        for (size_t b = 0; b < BUCKET_COUNT; ++b) fill[b] = bucketStart[b];
+        for (size_t i = 0; i < count_; ++i) {
+            order[fill[(mix(keys_[i], seed) >> 16) & (BUCKET_COUNT - 1)]++] = static_cast<uint16_t>(i);
+        }
+
+        // Place largest buckets first, searching a displacement for each
+        bool placed[BUCKET_COUNT] = {};
+        for (size_t round = 0; round < BUCKET_COUNT; ++round) {
+            size_t b = BUCKET_COUNT;
+            for (size_t c = 0; c < BUCKET_COUNT; ++c) {
+                if (!placed[c] && (b == BUCKET_COUNT || bucketSize[c] > bucketSize[b])) b = c;
+            }
+            placed[b] = true;
+            if (bucketSize[b] == 0) break;
+            if (!placeBucket(seed, b, order + bucketStart[b], bucketSize[b])) return false;
+        }
+        seed_ = seed;
+        return true;
+    }
+
+    bool placeBucket(uint32_t seed, size_t bucket, const uint16_t* members, size_t n) {
+        for (uint32_t d = 0; d < TABLE_SIZE; ++d) {
+            size_t i = 0;
+            for (; i < n; ++i) {
+                size_t slot = (mix(keys_[members[i]], seed) ^ d) & (TABLE_SIZE - 1);
+                if (slotKey_[slot] != EMPTY) break;
+                slotKey_[slot] = keys_[members[i]];  // claim, rolled back on failure
+                slotIndex_[slot] = members[i];
+            }
+            if (i == n) {
+                displacement_[bucket] = static_cast<uint16_t>(d);
+                return true;
+            }
+            while (i--) slotKey_[(mix(keys_[members[i]], seed) ^ d) & (TABLE_SIZE - 1)] = EMPTY;
+        }
+        return false;
+    }
+
+    uint16_t keys_[MaxBindings] = {};
+    Handler handlers_[MaxBindings] = {};
+    size_t count_ = 0;
+
+    uint16_t slotKey_[TABLE_SIZE];
+    uint16_t slotIndex_[TABLE_SIZE] = {};
+    uint16_t displacement_[BUCKET_COUNT];
+    uint32_t seed_ = 0;
+
+    SubscriptionSet subscribed_;
+};
+
+}  // namespace minimal::midi
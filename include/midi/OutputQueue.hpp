@@ -0,0 +1,363 @@
+#pragma once
+
+/**
+ * @file OutputQueue.hpp
+ * @brief USB-MIDI output that survives disconnects and host stalls
+ *
+ * While the host reads, write() goes straight to the USB buffer. Output is
+ * held back instead when:
+ * - USB is not configured (unplugged, re-enumerating): the Teensy core
+ *   would drop the packet
+ * - the host stalls: a write that blocks longer than STALL_US means every
+ *   TX buffer is full. The core then waits its timeout once and drops
+ *   everything after it without telling the caller.
+ *
+ * Held output collapses to state: a CC for a (channel, controller) or a
+ * pitch bend for a channel already queued overwrites the queued value in
+ * place, so a knob turned during a disconnect costs one slot, not one per
+ * tick. Program changes and channel pressure queue in order; when the
+ * queue is full they are dropped and counted.
+ *
+ * Notes (on, off, poly pressure) are not held: replayed late they are
+ * wrong, and a full queue could keep a NoteOff while losing its NoteOn or
+ * the reverse. They are dropped and counted, and their channel is marked.
+ * An earlier NoteOn may be sounding with its NoteOff among the dropped, so
+ * the replay starts with All Notes Off (CC 123) on each marked channel.
+ *
+ * poll() replays the queue in order (by first change) once USB is back,
+ * after a settle delay, in batches of one USB packet, each only after the
+ * host has taken all pending TX data. Direct writes resume when the queue
+ * is empty.
+ *
+ * write(), flush(), sendSysEx() and poll() run from loop() / binding callbacks.
+ * writeFromIsr() is for hardware-timer events (note repeat). It never
+ * waits: the core's TX path blocks (up to its timeout) when every transfer
+ * is still queued for the host, so an interrupt writes only when the MIDI
+ * TX endpoint is idle and loop() is not inside a write. Otherwise the
+ * packets wait in a small ring. Every loop() write sends the ring before
+ * its own packet and again before it returns, and poll() sends it once the
+ * endpoint is idle, so output stays in the order it was produced (a
+ * deferred retrigger never follows the release's NoteOff). The caller learns whether its packets went
+ * out, waited or were dropped. The Teensy USB-MIDI TX path is not
+ * reentrant; only writes through this queue are covered, so other senders
+ * (midi().send*) must not run while timer events are active.
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include <Arduino.h>
+
+#include "metrics/StandardMetrics.hpp"
+#include "midi/UsbConnection.hpp"
+
+namespace minimal::midi {
+
+enum class OutputMode : uint8_t { Direct, Collapse };
+
+/// What writeFromIsr() did with a group of packets
+enum class IsrWrite : uint8_t {
+    Sent,      ///< handed to USB now
+    Deferred,  ///< queued for loop(): goes out late
+    Dropped,   ///< output held or ring full: at least one packet lost
+};
+
+template <uint8_t Capacity>
+class OutputQueue {
+    static_assert(Capacity > 0 && Capacity < 0xFF, "slot index is 8-bit");
+
+public:
+    /// A write blocking longer than this is a host stall (USB frames are 1 ms)
+    static constexpr uint32_t STALL_US = 2000;
+
+    /// Delay between USB configuration and replay (host driver setup)
+    static constexpr uint32_t SETTLE_MS = 100;
+
+    /// Packets per replay batch (one 64-byte full-speed packet)
+    static constexpr uint8_t BATCH = 16;
+
+    OutputQueue() {
+        for (auto& s : slotOf_) s = EMPTY;
+    }
+
+    void write(uint32_t word) {
+        bool deferred = beginWrite();
+        writeHeld(word);
+        endWrite(deferred);
+    }
+
+    /// usbMIDI.send_now(), safe against writeFromIsr()
+    void flush() {
+        beginWrite();
+        usbMIDI.send_now();
+        endWrite();
+    }
+
+    /**
+     * @brief Send a complete SysEx message (F0 ... F7), safe against writeFromIsr()
+     *
+     * Never held: a dump is only useful live. While output is held it is
+     * dropped and counted; a write that stalls holds output like write().
+     */
+    void sendSysEx(const uint8_t* data, uint16_t length) {
+        if (mode_ != OutputMode::Direct || !usbConfigured()) {
+            metrics::standard::midiOutDropped.inc();
+            return;
+        }
+        bool deferred = beginWrite();
+        uint32_t start = micros();
+        usbMIDI.sendSysEx(length, data, true);
+        if (micros() - start >= STALL_US) holdAfterStall();
+        endWrite(deferred);
+    }
+
+    /**
+     * @brief Write and flush from interrupt context, without ever blocking
+     *
+     * Dropped (and counted) while output is held: a late timed note is
+     * worse than a missing one.
+     */
+    IsrWrite writeFromIsr(const uint32_t* words, uint8_t count) {
+        if (mode_ != OutputMode::Direct) {
+            for (uint8_t i = 0; i < count; ++i) drop(words[i]);
+            return IsrWrite::Dropped;
+        }
+        if (busy_ || deferredHead_ != deferredTail_ || !txIdle()) {
+            IsrWrite result = IsrWrite::Deferred;
+            for (uint8_t i = 0; i < count; ++i) {
+                uint8_t next = static_cast<uint8_t>((deferredTail_ + 1) % DEFERRED);
+                if (next == deferredHead_) {
+                    drop(words[i]);
+                    result = IsrWrite::Dropped;
+                    continue;
+                }
+                deferred_[deferredTail_] = words[i];
+                deferredTail_ = next;
+            }
+            deferredWrites_.inc();
+            return result;
+        }
+        // Every TX transfer is free: the core takes these without waiting
+        for (uint8_t i = 0; i < count; ++i) usb_midi_write_packed(words[i]);
+        usbMIDI.send_now();
+        return IsrWrite::Sent;
+    }
+
+    /**
+     * @brief Track the connection and replay held output
+     * @return true while output is held back
+     */
+    bool poll() {
+        if (connection_.update() && connection_.connected()) {
+            metrics::standard::usbReconnects.inc();
+        }
+        if (mode_ == OutputMode::Direct) {
+            // Interrupt writes deferred while the endpoint was busy, and notes
+            // an interrupt could not defer (ring full); sent once the host
+            // has taken pending data, so loop() does not wait either
+            bool pending = deferredHead_ != deferredTail_ ||
+                           notesOffChannels_.load(std::memory_order_relaxed);
+            if (pending && txIdle()) {
+                bool sent = beginWrite();
+                sent |= writeNotesOff() > 0;
+                endWrite(sent);
+            }
+            return false;
+        }
+        if (!connection_.connected()) return true;
+
+        uint32_t now = millis();
+        if (connection_.connectedForMs(now) < SETTLE_MS) return true;
+        if (now - stalledAtMs_ < SETTLE_MS || !txIdle()) return true;
+
+        // Release notes whose NoteOff was dropped, before any held state
+        uint8_t sent = writeNotesOff();
+        while (count_ > 0 && sent < BATCH) {
+            usb_midi_write_packed(pop());
+            ++sent;
+        }
+        if (sent) usbMIDI.send_now();
+        if (count_ == 0) mode_ = OutputMode::Direct;
+        return count_ > 0;
+    }
+
+    OutputMode mode() const { return mode_; }
+
+    /// Channels that get All Notes Off at the start of the replay (bit n = channel n)
+    uint16_t notesOffPending() const { return notesOffChannels_.load(std::memory_order_relaxed); }
+    uint8_t pending() const { return count_; }
+
+private:
+    static constexpr uint8_t EMPTY = 0xFF;
+
+    /// Interrupt writes that arrived during a loop() write
+    static constexpr uint8_t DEFERRED = 16;
+
+    static constexpr uint8_t ALL_NOTES_OFF = 123;
+
+    /// Collapse keys: (channel, controller) for CCs, then one per channel for pitch bend
+    static constexpr uint16_t STATE_KEYS = 16 * 128 + 16;
+
+    void writeHeld(uint32_t word) {
+        if (mode_ == OutputMode::Direct) {
+            if (!usbConfigured()) {
+                mode_ = OutputMode::Collapse;
+            } else {
+                uint32_t start = micros();
+                usb_midi_write_packed(word);
+                if (micros() - start < STALL_US) return;
+                holdAfterStall();
+                // Only state is safe to send twice (it may or may not have gone out)
+                if (!isState(word)) {
+                    if (isNote(word)) markNotesOff(word);
+                    return;
+                }
+            }
+        }
+        if (isNote(word)) {
+            drop(word);
+            return;
+        }
+        enqueue(word);
+    }
+
+    void holdAfterStall() {
+        mode_ = OutputMode::Collapse;
+        stalledAtMs_ = millis();
+        metrics::standard::midiOutStalls.inc();
+    }
+
+    /// All Notes Off on every marked channel; @return packets written
+    uint8_t writeNotesOff() {
+        uint16_t channels = notesOffChannels_.exchange(0, std::memory_order_relaxed);
+        uint8_t sent = 0;
+        for (uint8_t ch = 0; ch < 16; ++ch) {
+            if (!(channels & (1u << ch))) continue;
+            usb_midi_write_packed(packCC(ch, ALL_NOTES_OFF, 0));
+            ++sent;
+        }
+        return sent;
+    }
+
+    /// Count a message that will not be sent; a lost note marks its channel
+    void drop(uint32_t word) {
+        metrics::standard::midiOutDropped.inc();
+        if (isNote(word)) markNotesOff(word);
+    }
+
+    void markNotesOff(uint32_t word) {
+        notesOffChannels_.fetch_or(static_cast<uint16_t>(1u << ((word >> 8) & 0x0F)),
+                                   std::memory_order_relaxed);
+    }
+
+    /**
+     * Take the TX path from interrupts and send what they deferred earlier,
+     * so it goes out before the caller's packet (a deferred retrigger must
+     * not follow the release's NoteOff). @return true if anything was written
+     */
+    bool beginWrite() {
+        busy_ = true;
+        return writeDeferred();
+    }
+
+    /// Send what interrupts deferred during the write, then let them write directly
+    void endWrite(bool sent = false) {
+        for (;;) {
+            sent |= writeDeferred();
+            if (sent) usbMIDI.send_now();
+            busy_ = false;
+            // An interrupt between the drain and the flag cleared deferred again
+            if (deferredHead_ == deferredTail_) return;
+            busy_ = true;
+            sent = false;
+        }
+    }
+
+    bool writeDeferred() {
+        bool sent = false;
+        while (deferredHead_ != deferredTail_) {
+            usb_midi_write_packed(deferred_[deferredHead_]);
+            deferredHead_ = static_cast<uint8_t>((deferredHead_ + 1) % DEFERRED);
+            sent = true;
+        }
+        return sent;
+    }
+
+    /// USB-MIDI code index (low nibble of the packet)
+    static uint8_t cin(uint32_t word) { return word & 0x0F; }
+
+    /// NoteOff, NoteOn, poly pressure
+    static bool isNote(uint32_t word) { return cin(word) >= 0x8 && cin(word) <= 0xA; }
+
+    /// CC or pitch bend: only the last value matters
+    static bool isState(uint32_t word) { return cin(word) == 0xB || cin(word) == 0xE; }
+
+    /// CC: (channel, controller) → 0-2047; pitch bend: 2048 + channel
+    static uint16_t stateKey(uint32_t word) {
+        uint16_t channel = (word >> 8) & 0x0F;
+        if (cin(word) == 0xE) return static_cast<uint16_t>(16 * 128 + channel);
+        return static_cast<uint16_t>(channel << 7 | ((word >> 16) & 0x7F));
+    }
+
+    static uint32_t packCC(uint8_t channel, uint8_t cc, uint8_t value) {
+        return 0x0Bu | (static_cast<uint32_t>(0xB0 | channel) << 8) |
+               (static_cast<uint32_t>(cc) << 16) | (static_cast<uint32_t>(value) << 24);
+    }
+
+    void enqueue(uint32_t word) {
+        if (isState(word)) {
+            uint8_t slot = slotOf_[stateKey(word)];
+            if (slot != EMPTY) {
+                words_[slot] = word;  // collapse: keep the position, take the value
+                return;
+            }
+        }
+        if (count_ == Capacity) {
+            metrics::standard::midiOutDropped.inc();
+            return;
+        }
+        uint8_t slot = static_cast<uint8_t>((head_ + count_) % Capacity);
+        words_[slot] = word;
+        if (isState(word)) slotOf_[stateKey(word)] = slot;
+        ++count_;
+    }
+
+    uint32_t pop() {
+        uint32_t word = words_[head_];
+        if (isState(word) && slotOf_[stateKey(word)] == head_) slotOf_[stateKey(word)] = EMPTY;
+        head_ = static_cast<uint8_t>((head_ + 1) % Capacity);
+        --count_;
+        return word;
+    }
+
+    /// True when the host has taken every pending MIDI TX transfer
+    static bool txIdle() {
+#if defined(USB1_ENDPTSTAT) && defined(MIDI_TX_ENDPOINT)
+        return (USB1_ENDPTSTAT & (1u << (16 + MIDI_TX_ENDPOINT))) == 0;
+#else
+        return true;
+#endif
+    }
+
+    uint32_t words_[Capacity] = {};
+    uint8_t slotOf_[STATE_KEYS];
+    UsbConnection connection_;
+    uint32_t stalledAtMs_ = 0;
+    uint8_t head_ = 0;
+    uint8_t count_ = 0;
+    volatile OutputMode mode_ = OutputMode::Direct;
+    std::atomic<uint16_t> notesOffChannels_{0};
+
+    uint32_t deferred_[DEFERRED] = {};
+    volatile uint8_t deferredHead_ = 0;
+    volatile uint8_t deferredTail_ = 0;
+    volatile bool busy_ = false;
+
+    inline static metrics::Counter deferredWrites_{"midi.out.isr_deferred"};
+};
+
+/// The example's USB-MIDI output (context sendCC and pre-encoded packets)
+inline OutputQueue<64> usbOut;
+
+}  // namespace minimal::midi
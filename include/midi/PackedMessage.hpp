@@ -0,0 +1,120 @@
+#pragma once
+
+/**
+ * @file PackedMessage.hpp
+ * @brief Pre-encoded USB-MIDI event packets for fixed-value bindings
+ *
+ * A binding like press → sendCC(ch, 20, 127) sends the same 4 bytes every
+ * time. sendsCC() encodes the USB-MIDI packet once (at compile time when
+ * the arguments are constants) and returns a callable that only writes the
+ * pre-built 32-bit word into the USB-MIDI output: no range checks, no
+ * encoding, no MidiAPI indirection.
+ *
+ * @code
+ * onButton(id).press().then(minimal::midi::sendsCC<0, 20, 127>());
+ * onButton(id).release().then(minimal::midi::sendsCC(ch, cc, 0));
+ * @endcode
+ *
+ * Packets go through usbOut (midi/OutputQueue.hpp), like the context's own
+ * CC output, so ordering is preserved and nothing is lost while the host
+ * is disconnected or stalled.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include <Arduino.h>
+
+#include "metrics/StandardMetrics.hpp"
+#include "midi/OutputQueue.hpp"
+
+namespace minimal::midi {
+
+/// USB-MIDI Code Index Numbers (USB MIDI 1.0, table 4-1)
+enum class Cin : uint8_t {
+    NoteOff = 0x8,
+    NoteOn = 0x9,
+    PolyPressure = 0xA,
+    ControlChange = 0xB,
+    ProgramChange = 0xC,
+    ChannelPressure = 0xD,
+    PitchBend = 0xE,
+};
+
+/**
+ * @brief Encode a channel message as a little-endian USB-MIDI packet
+ * @param channel 0-15 (masked), data bytes masked to 7 bits
+ */
+constexpr uint32_t packUsbMidi(Cin cin, uint8_t channel, uint8_t data1, uint8_t data2,
+                               uint8_t cable = 0) {
+    uint8_t code = static_cast<uint8_t>(cin);
+    uint8_t status = static_cast<uint8_t>((code << 4) | (channel & 0x0F));
+    return static_cast<uint32_t>(code | ((cable & 0x0F) << 4)) |
+           (static_cast<uint32_t>(status) << 8) | (static_cast<uint32_t>(data1 & 0x7F) << 16) |
+           (static_cast<uint32_t>(data2 & 0x7F) << 24);
+}
+
+/// Callable that writes one pre-built packet
+struct PackedSend {
+    uint32_t word;
+
+    void operator()() const {
+        usbOut.write(word);
+        metrics::standard::midiOut.inc();
+    }
+};
+
+/// Write pre-built packets back to back and flush them as one USB transfer
+inline void sendBurst(const uint32_t* words, size_t count) {
+    for (size_t i = 0; i < count; ++i) usbOut.write(words[i]);
+    if (usbOut.mode() == OutputMode::Direct) usbOut.flush();
+    metrics::standard::midiOut.add(static_cast<uint32_t>(count));
+}
+
+/// Collects packets and writes each full batch with sendBurst()
+template <size_t Capacity = 16>
+class PacketBatch {
+public:
+    void add(uint32_t word) {
+        if (count_ == Capacity) flush();
+        words_[count_++] = word;
+    }
+
+    void controlChange(uint8_t channel, uint8_t cc, uint8_t value) {
+        add(packUsbMidi(Cin::ControlChange, channel, cc, value));
+    }
+
+    void flush() {
+        if (count_ == 0) return;
+        sendBurst(words_, count_);
+        count_ = 0;
+    }
+
+private:
+    uint32_t words_[Capacity];
+    size_t count_ = 0;
+};
+
+/// Control Change packet, encoded at compile time
+template <uint8_t Channel, uint8_t CC, uint8_t Value>
+constexpr PackedSend sendsCC() {
+    static_assert(Channel < 16 && CC < 128 && Value < 128, "MIDI value out of range");
+    return PackedSend{packUsbMidi(Cin::ControlChange, Channel, CC, Value)};
+}
+
+/// Control Change packet, encoded once at bind time
+constexpr PackedSend sendsCC(uint8_t channel, uint8_t cc, uint8_t value) {
+    return PackedSend{packUsbMidi(Cin::ControlChange, channel, cc, value)};
+}
+
+/// Note On packet, encoded once at bind time
+constexpr PackedSend sendsNoteOn(uint8_t channel, uint8_t note, uint8_t velocity) {
+    return PackedSend{packUsbMidi(Cin::NoteOn, channel, note, velocity)};
+}
+
+/// Note Off packet, encoded once at bind time
+constexpr PackedSend sendsNoteOff(uint8_t channel, uint8_t note, uint8_t velocity = 0) {
+    return PackedSend{packUsbMidi(Cin::NoteOff, channel, note, velocity)};
+}
+
+}  // namespace minimal::midi
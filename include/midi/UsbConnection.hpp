@@ -0,0 +1,51 @@
+#pragma once
+
+/**
+ * @file UsbConnection.hpp
+ * @brief USB device state as seen by the MIDI output path
+ */
+
+#include <cstdint>
+
+#include <Arduino.h>
+
+#if defined(__IMXRT1062__)
+#include <usb_dev.h>
+#endif
+
+namespace minimal::midi {
+
+/// True once the host has enumerated and configured the device
+inline bool usbConfigured() {
+#if defined(__IMXRT1062__)
+    return usb_configuration != 0;
+#else
+    return true;
+#endif
+}
+
+/// Edge tracking for usbConfigured(), polled from loop()
+class UsbConnection {
+public:
+    /// @return true if the state changed since the last update()
+    bool update() {
+        bool now = usbConfigured();
+        if (now == connected_) return false;
+        connected_ = now;
+        if (now) connectedAtMs_ = millis();
+        return true;
+    }
+
+    bool connected() const { return connected_; }
+
+    /// Time since the host configured the device (0 while disconnected)
+    uint32_t connectedForMs(uint32_t nowMs) const {
+        return connected_ ? nowMs - connectedAtMs_ : 0;
+    }
+
+private:
+    uint32_t connectedAtMs_ = 0;
+    bool connected_ = false;
+};
+
+}  // namespace minimal::midi
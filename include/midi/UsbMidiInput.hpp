@@ -0,0 +1,61 @@
+#pragma once
+
+/**
+ * @file UsbMidiInput.hpp
+ * @brief Feeds Teensy usbMIDI input into an IncomingDispatcher
+ *
+ * The framework's MidiAPI is output-only, so the example reads usbMIDI
+ * itself. Call pollUsbMidi() from loop(); it stops after @p maxMessages so a
+ * DAW flood cannot starve the input scan. Realtime messages (MIDI clock,
+ * transport) bypass the dispatcher and go to one optional handler, complete
+ * SysEx messages (up to the core's USB_MIDI_SYSEX_MAX) to another.
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include <Arduino.h>
+
+#include "metrics/StandardMetrics.hpp"
+
+namespace minimal::midi {
+
+/// Handler for system realtime bytes (0xF8 clock, 0xFA start, 0xFB continue, 0xFC stop)
+struct RealtimeHandler {
+    void (*fn)(void* ctx, uint8_t type) = nullptr;
+    void* ctx = nullptr;
+};
+
+/// Handler for a SysEx message (F0 ... F7 included)
+struct SysExHandler {
+    void (*fn)(void* ctx, const uint8_t* data, size_t length) = nullptr;
+    void* ctx = nullptr;
+};
+
+/// Read pending usbMIDI messages and route them; returns messages read
+template <typename Dispatcher>
+size_t pollUsbMidi(const Dispatcher& dispatcher, RealtimeHandler realtime = {},
+                   SysExHandler sysex = {}, size_t maxMessages = 32) {
+    size_t n = 0;
+    while (n < maxMessages && usbMIDI.read()) {
+        ++n;
+        uint8_t type = usbMIDI.getType();
+        if (type >= 0xF8) {
+            if (realtime.fn) realtime.fn(realtime.ctx, type);
+            continue;
+        }
+        if (type == 0xF0) {
+            if (sysex.fn) sysex.fn(sysex.ctx, usbMIDI.getSysExArray(), usbMIDI.getSysExArrayLength());
+            continue;
+        }
+        if (type > 0xF0) continue;  // other system messages are not routed
+        uint8_t status = static_cast<uint8_t>(type | ((usbMIDI.getChannel() - 1) & 0x0F));
+        metrics::standard::midiIn.inc();
+        if (!dispatcher.dispatch(status, usbMIDI.getData1(), usbMIDI.getData2())) {
+            metrics::standard::midiInDropped.inc();
+        }
+    }
+    return n;
+}
+
+}  // namespace minimal::midi
@@ -0,0 +1,215 @@
+#pragma once
+
+/**
+ * @file ImuReader.hpp
+ * @brief IMU sampled by a timer + DMA over I2C, never by loop()
+ *
+ * A blocking Wire read of 14 bytes holds the CPU for the whole bus
+ * transaction: about 400 µs at 400 kHz, every sample. Here the bus runs
+ * on its own:
+ *
+ * 1. A PIT interrupt (IntervalTimer, MOTION_RATE_HZ) writes the whole
+ *    transaction into the LPI2C transmit FIFO as 4 command words: START +
+ *    write address, register, repeated START + read address, receive 14.
+ *    AUTOSTOP ends it with a STOP once the FIFO is empty. This takes
+ *    well under 1 µs.
+ * 2. The LPI2C receive-data DMA request moves each byte from MRDR into a
+ *    buffer. The CPU is not involved while the bus runs.
+ * 3. The DMA completion interrupt parses the sample and runs the
+ *    fixed-point filter (motion/Orientation.hpp), a few hundred cycles,
+ *    then publishes angles and shake for loop() under a sequence counter.
+ *
+ * loop() only reads the published values (MotionInput::poll()). Every
+ * sample goes through the filter even when loop() is slow, because gyro
+ * integration needs all of them.
+ *
+ * The bus is LPI2C3 on pins 16 (SCL1) / 17 (SDA1); Wire (18/19) carries
+ * encoder 2. begin() sets it up with Wire1 (pin mux, clock, 400 kHz
+ * timing) and writes the sensor configuration, blocking, once, from
+ * setup(). After that the driver owns the peripheral: do not use Wire1.
+ *
+ * Errors (NACK, arbitration loss, FIFO error) are checked at the next
+ * timer tick. The FIFOs are reset, the sample is skipped, and
+ * motion.i2c.errors counts it. A transaction still running at the next
+ * tick (bus slower than the rate) skips that tick and counts
+ * motion.overruns.
+ */
+
+#include <cstdint>
+
+#include <Arduino.h>
+
+#if defined(__IMXRT1062__)
+#include <DMAChannel.h>
+#include <Wire.h>
+#endif
+
+#include "metrics/Metrics.hpp"
+#include "motion/Mpu6050.hpp"
+#include "motion/Orientation.hpp"
+
+namespace minimal::motion {
+
+/// Filter output as published to loop()
+struct MotionState {
+    int16_t roll;    ///< binary angle, 16384 = 90°
+    int16_t pitch;
+    uint16_t shake;  ///< 0-32767
+    uint32_t sequence;
+};
+
+class ImuReader {
+public:
+    static constexpr uint32_t I2C_HZ = 400000;
+
+    /**
+     * @brief Configure bus and sensor, start sampling (setup() only: blocks a few ms)
+     * @return false if no known sensor answers at @p address
+     */
+    bool begin(uint8_t address, uint32_t rateHz) {
+        address_ = address;
+        filter_ = OrientationFilter(rateHz);
+#if defined(__IMXRT1062__)
+        Wire1.begin();
+        Wire1.setClock(I2C_HZ);
+        if (!mpu6050::knownId(readRegister(mpu6050::REG_WHO_AM_I))) return false;
+        for (const auto& write : mpu6050::INIT) {
+            Wire1.beginTransmission(address_);
+            Wire1.write(write.reg);
+            Wire1.write(write.value);
+            if (Wire1.endTransmission() != 0) return false;
+        }
+
+        // Wire1 leaves the master enabled; MCFGR1 is writable only while it is off
+        LPI2C3_MCR &= ~MCR_MEN;
+        LPI2C3_MCFGR1 |= MCFGR1_AUTOSTOP;
+        LPI2C3_MCR |= MCR_MEN;
+
+        instance_ = this;
+        dma_.begin();
+        dma_.source(LPI2C3_MRDR);
+        dma_.destinationBuffer(rx_, sizeof(rx_));
+        dma_.triggerAtHardwareEvent(DMAMUX_SOURCE_LPI2C3);
+        dma_.disableOnCompletion();
+        dma_.interruptAtCompletion();
+        dma_.attachInterrupt(&ImuReader::onDmaComplete);
+        running_ = timer_.begin(&ImuReader::onTimer, 1000000 / rateHz);
+        return running_;
+#else
+        (void)rateHz;
+        return false;
+#endif
+    }
+
+    bool running() const { return running_; }
+
+    /// Latest published state; @return false if nothing new since @p sequence
+    bool read(MotionState& out, uint32_t sequence) const {
+        for (;;) {
+            uint32_t before = sequence_;
+            if (before == sequence) return false;
+            if (before & 1u) continue;  // interrupt is writing
+            out = {roll_, pitch_, shake_, before};
+            if (sequence_ == before) return true;
+        }
+    }
+
+private:
+    // LPI2C master register bits (i.MX RT1060 reference manual, LPI2C chapter)
+    static constexpr uint32_t MCR_MEN = 1u << 0;
+    static constexpr uint32_t MCR_RTF = 1u << 8;
+    static constexpr uint32_t MCR_RRF = 1u << 9;
+    static constexpr uint32_t MSR_NDF = 1u << 10;
+    static constexpr uint32_t MSR_ALF = 1u << 11;
+    static constexpr uint32_t MSR_FEF = 1u << 12;
+    static constexpr uint32_t MSR_PLTF = 1u << 13;
+    static constexpr uint32_t MSR_ERRORS = MSR_NDF | MSR_ALF | MSR_FEF | MSR_PLTF;
+    static constexpr uint32_t MSR_CLEAR = 0x00007F00;  ///< all write-1-to-clear flags
+    static constexpr uint32_t MDER_RDDE = 1u << 1;
+    static constexpr uint32_t MCFGR1_AUTOSTOP = 1u << 8;
+    static constexpr uint32_t MTDR_RECEIVE = 1u << 8;  ///< receive DATA + 1 bytes
+    static constexpr uint32_t MTDR_START = 4u << 8;    ///< (repeated) START + address byte
+
+#if defined(__IMXRT1062__)
+    uint8_t readRegister(uint8_t reg) {
+        Wire1.beginTransmission(address_);
+        Wire1.write(reg);
+        if (Wire1.endTransmission(false) != 0) return 0;
+        if (Wire1.requestFrom(address_, static_cast<uint8_t>(1)) != 1) return 0;
+        return static_cast<uint8_t>(Wire1.read());
+    }
+
+    static void onTimer() { instance_->start(); }
+
+    static void onDmaComplete() { instance_->complete(); }
+
+    void start() {
+        if (busy_) {
+            if ((LPI2C3_MSR & MSR_ERRORS) == 0) {
+                overruns_.inc();
+                return;
+            }
+            recover();
+        }
+        LPI2C3_MSR = MSR_CLEAR;
+        dma_.destinationBuffer(rx_, sizeof(rx_));  // re-arm the major loop
+        dma_.enable();
+        LPI2C3_MDER = MDER_RDDE;
+        LPI2C3_MTDR = MTDR_START | static_cast<uint32_t>(address_ << 1);
+        LPI2C3_MTDR = mpu6050::REG_ACCEL_XOUT_H;
+        LPI2C3_MTDR = MTDR_START | static_cast<uint32_t>(address_ << 1 | 1);
+        LPI2C3_MTDR = MTDR_RECEIVE | (mpu6050::SAMPLE_BYTES - 1);
+        busy_ = true;
+    }
+
+    void complete() {
+        dma_.clearInterrupt();
+        LPI2C3_MDER = 0;
+        busy_ = false;
+
+        uint8_t bytes[mpu6050::SAMPLE_BYTES];
+        for (uint8_t k = 0; k < mpu6050::SAMPLE_BYTES; ++k) bytes[k] = static_cast<uint8_t>(rx_[k]);
+        filter_.update(mpu6050::parse(bytes));
+
+        sequence_ = sequence_ + 1;  // odd: writing
+        roll_ = filter_.roll();
+        pitch_ = filter_.pitch();
+        shake_ = filter_.shake();
+        sequence_ = sequence_ + 1;
+        samples_.inc();
+    }
+
+    /// Abandon a failed transaction (STOP is sent by the controller on NACK)
+    void recover() {
+        dma_.disable();
+        LPI2C3_MDER = 0;
+        LPI2C3_MCR |= MCR_RTF | MCR_RRF;
+        LPI2C3_MSR = MSR_CLEAR;
+        busy_ = false;
+        errors_.inc();
+    }
+
+    inline static ImuReader* instance_ = nullptr;
+    inline static IntervalTimer timer_;
+    inline static DMAChannel dma_;
+
+    /// MRDR words (data in bits 0-7); DTCM, so DMA writes need no cache maintenance
+    uint32_t rx_[mpu6050::SAMPLE_BYTES] = {};
+#endif
+
+    OrientationFilter filter_{200};
+    uint8_t address_ = mpu6050::DEFAULT_ADDRESS;
+    volatile bool busy_ = false;
+    bool running_ = false;
+
+    volatile uint32_t sequence_ = 0;
+    volatile int16_t roll_ = 0;
+    volatile int16_t pitch_ = 0;
+    volatile uint16_t shake_ = 0;
+
+    inline static metrics::Counter samples_{"motion.samples"};
+    inline static metrics::Counter errors_{"motion.i2c.errors"};
+    inline static metrics::Counter overruns_{"motion.overruns"};
+};
+
+}  // namespace minimal::motion
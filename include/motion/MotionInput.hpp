@@ -0,0 +1,134 @@
+#pragma once
+
+/**
+ * @file MotionInput.hpp
+ * @brief Tilt and shake as bindable inputs, like encoders
+ *
+ * @code
+ * onMotion(motion::Axis::Roll).move().then(minimal::input::stream<float>()
+ *     .quantize<127>()
+ *     .changed()
+ *     .then([this](uint8_t v) { midi().sendCC(ch, cc, v); }));
+ * @endcode
+ *
+ * Values are normalized like an encoder position:
+ * - Roll / Pitch: -90° → 0.0, level → 0.5, +90° → 1.0 (clamped beyond)
+ * - Shake: 0.0 at rest → 1.0 at full intensity
+ *
+ * poll(), from loop() (outside app->update()), reads the state the IMU
+ * interrupt published (motion/ImuReader.hpp) and calls the bindings of
+ * each axis that moved by at least DEADBAND since its last event, so
+ * sensor noise on a device lying still produces no events. It never
+ * touches the bus.
+ *
+ * Bindings are copied into fixed inline slots (MAX_BINDINGS, each up to
+ * MAX_CALLABLE_BYTES): no allocation, and a pipeline that does not fit
+ * fails at compile time.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "motion/ImuReader.hpp"
+
+namespace minimal::motion {
+
+enum class Axis : uint8_t { Roll, Pitch, Shake };
+
+class MotionInput {
+public:
+    static constexpr uint8_t AXES = 3;
+    static constexpr uint8_t MAX_BINDINGS = 8;
+    static constexpr size_t MAX_CALLABLE_BYTES = 64;
+
+    /// Smallest change that produces an event (Q15 units: 128 ≈ 0.7° of tilt)
+    static constexpr int32_t DEADBAND = 128;
+
+    class Binding {
+    public:
+        Binding(MotionInput& input, Axis axis) : input_(input), axis_(axis) {}
+
+        /// Every change of the axis beyond the deadband
+        Binding& move() { return *this; }
+
+        /// @return false if all MAX_BINDINGS slots are taken
+        template <typename Fn>
+        bool then(Fn fn) {
+            return input_.bind(axis_, std::move(fn));
+        }
+
+    private:
+        MotionInput& input_;
+        Axis axis_;
+    };
+
+    explicit MotionInput(ImuReader& reader) : reader_(reader) {}
+
+    Binding on(Axis axis) { return Binding(*this, axis); }
+
+    /// Deliver what changed since the last call; call every loop
+    void poll() {
+        MotionState state;
+        if (!reader_.read(state, sequence_)) return;
+        sequence_ = state.sequence;
+        emit(Axis::Roll, state.roll);
+        emit(Axis::Pitch, state.pitch);
+        emit(Axis::Shake, state.shake);
+    }
+
+private:
+    struct Slot {
+        alignas(std::max_align_t) unsigned char storage[MAX_CALLABLE_BYTES];
+        void (*call)(void* fn, float value);
+        Axis axis;
+    };
+
+    template <typename Fn>
+    bool bind(Axis axis, Fn fn) {
+        static_assert(sizeof(Fn) <= MAX_CALLABLE_BYTES, "binding too large for a motion slot");
+        static_assert(alignof(Fn) <= alignof(std::max_align_t), "binding over-aligned");
+        static_assert(std::is_trivially_destructible_v<Fn>, "bindings are never destroyed");
+        if (count_ == MAX_BINDINGS) return false;
+        Slot& slot = slots_[count_++];
+        new (slot.storage) Fn(std::move(fn));
+        slot.call = [](void* stored, float value) { (*static_cast<Fn*>(stored))(value); };
+        slot.axis = axis;
+        return true;
+    }
+
+    void emit(Axis axis, int32_t raw) {
+        auto a = static_cast<uint8_t>(axis);
+        int32_t moved = raw - last_[a];
+        if (primed_[a] && moved < DEADBAND && moved > -DEADBAND) return;
+        last_[a] = raw;
+        primed_[a] = true;
+        float value = normalize(axis, raw);
+        for (uint8_t k = 0; k < count_; ++k) {
+            if (slots_[k].axis == axis) slots_[k].call(slots_[k].storage, value);
+        }
+    }
+
+    static float normalize(Axis axis, int32_t raw) {
+        if (axis == Axis::Shake) return static_cast<float>(raw) * (1.0f / 32767.0f);
+        float value = 0.5f + static_cast<float>(raw) * (1.0f / 32768.0f);  // 16384 = 90°
+        if (value < 0.0f) return 0.0f;
+        if (value > 1.0f) return 1.0f;
+        return value;
+    }
+
+    ImuReader& reader_;
+    Slot slots_[MAX_BINDINGS] = {};
+    uint8_t count_ = 0;
+    uint32_t sequence_ = 0;
+    int32_t last_[AXES] = {};
+    bool primed_[AXES] = {};
+};
+
+/// The example's IMU and its bindings (ScheduledContext::onMotion())
+inline ImuReader imu;
+inline MotionInput motionInput{imu};
+
+}  // namespace minimal::motion
@@ -0,0 +1,67 @@
+#pragma once
+
+/**
+ * @file Mpu6050.hpp
+ * @brief MPU-6050 / MPU-6500 register map and sample parsing
+ *
+ * One burst read from ACCEL_XOUT_H returns accelerometer, temperature and
+ * gyroscope, 14 bytes big-endian. The configuration written at begin()
+ * sets ±2 g, ±500 °/s and a 44 Hz low-pass (the sensor's own anti-alias
+ * filter, below half the 200 Hz read rate).
+ */
+
+#include <cstdint>
+
+namespace minimal::motion {
+
+/// Raw sensor axes (accel: 16384 LSB/g, gyro: 65.5 LSB per °/s)
+struct ImuSample {
+    int16_t accel[3];
+    int16_t gyro[3];
+};
+
+namespace mpu6050 {
+
+constexpr uint8_t DEFAULT_ADDRESS = 0x68;  ///< 0x69 with AD0 high
+
+constexpr uint8_t REG_SMPLRT_DIV = 0x19;
+constexpr uint8_t REG_CONFIG = 0x1A;
+constexpr uint8_t REG_GYRO_CONFIG = 0x1B;
+constexpr uint8_t REG_ACCEL_CONFIG = 0x1C;
+constexpr uint8_t REG_ACCEL_XOUT_H = 0x3B;
+constexpr uint8_t REG_PWR_MGMT_1 = 0x6B;
+constexpr uint8_t REG_WHO_AM_I = 0x75;
+
+/// Bytes per burst read (accel, temperature, gyro)
+constexpr uint8_t SAMPLE_BYTES = 14;
+
+constexpr float ACCEL_LSB_PER_G = 16384.0f;
+constexpr float GYRO_LSB_PER_DPS = 65.5f;
+
+struct RegisterWrite {
+    uint8_t reg;
+    uint8_t value;
+};
+
+/// Written once at begin(), in order
+constexpr RegisterWrite INIT[] = {
+    {REG_PWR_MGMT_1, 0x01},    // wake, clock from the X gyro PLL
+    {REG_SMPLRT_DIV, 0x04},    // 1 kHz / 5 = 200 Hz output rate
+    {REG_CONFIG, 0x03},        // DLPF 44 Hz
+    {REG_GYRO_CONFIG, 0x08},   // ±500 °/s
+    {REG_ACCEL_CONFIG, 0x00},  // ±2 g
+};
+
+/// WHO_AM_I answers: MPU-6050, MPU-6500, MPU-9250
+constexpr bool knownId(uint8_t id) { return id == 0x68 || id == 0x70 || id == 0x71; }
+
+/// Burst from ACCEL_XOUT_H → sample (temperature skipped)
+inline ImuSample parse(const uint8_t* bytes) {
+    auto be = [bytes](uint8_t at) {
+        return static_cast<int16_t>(static_cast<uint16_t>(bytes[at] << 8 | bytes[at + 1]));
+    };
+    return {{be(0), be(2), be(4)}, {be(8), be(10), be(12)}};
+}
+
+}  // namespace mpu6050
+}  // namespace minimal::motion
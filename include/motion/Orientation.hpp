@@ -0,0 +1,127 @@
+#pragma once
+
+/**
+ * @file Orientation.hpp
+ * @brief Fixed-point tilt (roll / pitch) and shake from accelerometer + gyro
+ *
+ * Complementary filter: each sample integrates the gyro rate into the angle
+ * (fast, but drifts), then pulls the angle 1/2^ALPHA_SHIFT of the way
+ * toward the tilt the accelerometer measures (noisy and disturbed by
+ * motion, but no drift). At 200 Hz, ALPHA_SHIFT = 6 gives about 0.3 s time
+ * constant for drift correction.
+ *
+ * Angles are binary: a full turn is 2^32, so wrap-around is plain integer
+ * overflow and the top 16 bits are the usual int16 binary angle (±32768 =
+ * ±180°). atan2 is an octant-reduced polynomial, max error about 0.25°.
+ * Everything is integer, so update() runs in the sample interrupt.
+ *
+ * Shake is an envelope of the change in acceleration between samples
+ * (jerk), 0-32767: it rises at once and decays over about 80 ms.
+ */
+
+#include <cstdint>
+
+#include "motion/Mpu6050.hpp"
+
+namespace minimal::motion {
+
+/// atan2 as an int16 binary angle (32768 = 180°)
+inline int16_t atan2Angle(int32_t y, int32_t x) {
+    if (x == 0 && y == 0) return 0;
+    uint32_t ax = static_cast<uint32_t>(x < 0 ? -x : x);
+    uint32_t ay = static_cast<uint32_t>(y < 0 ? -y : y);
+    bool steep = ay > ax;
+    uint32_t num = steep ? ax : ay;
+    uint32_t den = steep ? ay : ax;
+    while (num >= (1u << 16)) {  // keep num << 15 in 32 bits
+        num >>= 1;
+        den >>= 1;
+    }
+    auto r = static_cast<int32_t>((num << 15) / den);  // tan, Q15 0-1
+    // θ ≈ π/4·r + 0.273·r·(1 − r) rad, in binary units (π/4 = 8192, 0.273 rad = 2847)
+    int32_t angle = (8192 * r + 2847 * ((r * (32768 - r)) >> 15)) >> 15;
+    if (steep) angle = 16384 - angle;
+    if (x < 0) angle = 32768 - angle;
+    if (y < 0) angle = -angle;
+    return static_cast<int16_t>(static_cast<uint16_t>(angle));
+}
+
+/// floor(sqrt(v))
+inline uint32_t isqrt(uint32_t v) {
+    uint32_t root = 0;
+    for (uint32_t bit = 1u << 30; bit != 0; bit >>= 2) {
+        if (v >= root + bit) {
+            v -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+    }
+    return root;
+}
+
+class OrientationFilter {
+public:
+    static constexpr uint8_t ALPHA_SHIFT = 6;
+
+    /// Shake envelope decay per sample (1/2^n)
+    static constexpr uint8_t SHAKE_DECAY_SHIFT = 4;
+
+    /// Jerk below this (LSB, ~0.06 g) is sensor noise or hand tremor, not shake
+    static constexpr uint32_t SHAKE_FLOOR = 1024;
+
+    /// @param sampleHz rate update() is called at (gyro integration step)
+    explicit OrientationFilter(uint32_t sampleHz)
+        : gyroStep_(static_cast<int32_t>(4294967296.0 / 360.0 / mpu6050::GYRO_LSB_PER_DPS /
+                                          static_cast<double>(sampleHz) + 0.5)) {}
+
+    void update(const ImuSample& s) {
+        int32_t ax = s.accel[0], ay = s.accel[1], az = s.accel[2];
+
+        // Tilt the accelerometer measures (gravity direction)
+        uint32_t yz = isqrt(static_cast<uint32_t>(ay * ay) + static_cast<uint32_t>(az * az));
+        uint32_t accelRoll = static_cast<uint32_t>(atan2Angle(ay, az)) << 16;
+        uint32_t accelPitch = static_cast<uint32_t>(atan2Angle(-ax, static_cast<int32_t>(yz))) << 16;
+
+        if (!primed_) {
+            roll_ = accelRoll;
+            pitch_ = accelPitch;
+            for (uint8_t k = 0; k < 3; ++k) last_[k] = s.accel[k];
+            primed_ = true;
+        } else {
+            roll_ += static_cast<uint32_t>(s.gyro[0] * gyroStep_);
+            pitch_ += static_cast<uint32_t>(s.gyro[1] * gyroStep_);
+            roll_ += static_cast<uint32_t>(static_cast<int32_t>(accelRoll - roll_) >> ALPHA_SHIFT);
+            pitch_ += static_cast<uint32_t>(static_cast<int32_t>(accelPitch - pitch_) >> ALPHA_SHIFT);
+        }
+
+        // Jerk: L1 change of acceleration above the floor, 1 g per sample ≈ full scale
+        uint32_t jerk = 0;
+        for (uint8_t k = 0; k < 3; ++k) {
+            int32_t d = s.accel[k] - last_[k];
+            jerk += static_cast<uint32_t>(d < 0 ? -d : d);
+            last_[k] = s.accel[k];
+        }
+        uint32_t level = jerk > SHAKE_FLOOR ? (jerk - SHAKE_FLOOR) * 2 : 0;
+        if (level > 32767) level = 32767;
+        shake_ -= shake_ >> SHAKE_DECAY_SHIFT;
+        if (level > shake_) shake_ = level;
+    }
+
+    /// int16 binary angles (16384 = 90°)
+    int16_t roll() const { return static_cast<int16_t>(roll_ >> 16); }
+    int16_t pitch() const { return static_cast<int16_t>(pitch_ >> 16); }
+
+    /// Shake intensity 0-32767
+    uint16_t shake() const { return static_cast<uint16_t>(shake_); }
+
+private:
+    int32_t gyroStep_;  ///< angle units (2^32 per turn) per gyro LSB per sample
+    uint32_t roll_ = 0;
+    uint32_t pitch_ = 0;
+    uint32_t shake_ = 0;
+    int16_t last_[3] = {};
+    bool primed_ = false;
+};
+
+}  // namespace minimal::motion
@@ -0,0 +1,157 @@
+#pragma once
+
+/**
+ * @file ModMatrix.hpp
+ * @brief Sources → destinations with depth, evaluated only where needed
+ *
+ * Sources (encoders, analog inputs, LFOs, incoming MIDI) and destinations
+ * (parameters) are plain indices; all values are Q15. Each destination's
+ * output is
+ *
+ *   out[d] = saturate(base[d] + Σ depth[k] · source[src[k]])   over d's connections
+ *
+ * Connections are stored structure-of-arrays (depth, source index) and
+ * kept sorted by destination, so each destination's terms are one
+ * contiguous run. The MAC runs two terms per SMLALD on the M7
+ * (dsp/Simd.hpp; portable loop off-target, same result).
+ *
+ * Only destinations whose base or any connected source changed are
+ * recomputed: setSource() ORs a precomputed per-source destination mask
+ * into a dirty bitset, evaluate() walks the set bits.
+ *
+ * @code
+ * ModMatrix<64, SOURCE_COUNT, PARAM_COUNT> mod;
+ * mod.connect(SRC_LFO, PARAM_CUTOFF, 0.25f);
+ * mod.setBase(PARAM_CUTOFF, toQ15(encoderValue));
+ * mod.setSource(SRC_LFO, lfo.next());
+ * mod.evaluate([&](uint8_t dest, int16_t q15) { params.set(dest, fromQ15(q15)); });
+ * @endcode
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include "dsp/Simd.hpp"
+
+namespace minimal::param {
+
+template <size_t MaxConnections, size_t Sources, size_t Destinations>
+class ModMatrix {
+    static_assert(Sources <= 0xFF && Destinations <= 0xFF, "indices are 8-bit");
+    static_assert(MaxConnections <= 0xFFFF, "connection offsets are 16-bit");
+
+public:
+    /**
+     * @brief Add a connection (depth -1..1)
+     * @return false if the connection list is full
+     */
+    bool connect(uint8_t source, uint8_t destination, float depth) {
+        if (count_ == MaxConnections || source >= Sources || destination >= Destinations) {
+            return false;
+        }
+        // Insert at the end of the destination's run, shift the rest up
+        size_t at = begin_[destination + 1];
+        for (size_t k = count_; k > at; --k) {
+            depth_[k] = depth_[k - 1];
+            source_[k] = source_[k - 1];
+        }
+        depth_[at] = dsp::toQ15(depth);
+        source_[at] = source;
+        ++count_;
+        for (size_t d = destination + 1; d <= Destinations; ++d) ++begin_[d];
+        affects_[source][destination / 32] |= 1u << (destination % 32);
+        markDirty(destination);
+        return true;
+    }
+
+    /// Remove every connection (destinations return to their base)
+    void clear() {
+        count_ = 0;
+        for (auto& b : begin_) b = 0;
+        for (auto& row : affects_) {
+            for (auto& word : row) word = 0;
+        }
+        for (size_t d = 0; d < Destinations; ++d) markDirty(static_cast<uint8_t>(d));
+    }
+
+    void setSource(uint8_t source, int16_t value) {
+        if (sources_[source] == value) return;
+        sources_[source] = value;
+        for (size_t w = 0; w < DEST_WORDS; ++w) dirty_[w] |= affects_[source][w];
+    }
+
+    void setBase(uint8_t destination, int16_t value) {
+        if (base_[destination] == value) return;
+        base_[destination] = value;
+        markDirty(destination);
+    }
+
+    /// True if @p destination has at least one connection
+    bool modulates(uint8_t destination) const {
+        return begin_[destination + 1] != begin_[destination];
+    }
+
+    bool dirty() const {
+        for (uint32_t word : dirty_) {
+            if (word) return true;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Recompute dirty destinations and hand each result to @p out
+     * @param out callable `void(uint8_t destination, int16_t q15)`
+     * @return number of destinations recomputed
+     */
+    template <typename Out>
+    size_t evaluate(Out&& out) {
+        size_t evaluated = 0;
+        for (size_t w = 0; w < DEST_WORDS; ++w) {
+            uint32_t bits = dirty_[w];
+            dirty_[w] = 0;
+            while (bits) {
+                uint8_t d = static_cast<uint8_t>(w * 32 + __builtin_ctz(bits));
+                bits &= bits - 1;
+                out(d, compute(d));
+                ++evaluated;
+            }
+        }
+        return evaluated;
+    }
+
+    /// Output for one destination (no dirty tracking)
+    int16_t compute(uint8_t destination) const {
+        size_t k = begin_[destination];
+        const size_t end = begin_[destination + 1];
+        int64_t acc = 0;  // full-scale terms are 2^30: two already overflow 32 bits
+        for (; k + 1 < end; k += 2) {
+            acc = dsp::smlald(dsp::pack16(depth_[k], depth_[k + 1]),
+                              dsp::pack16(sources_[source_[k]], sources_[source_[k + 1]]), acc);
+        }
+        if (k < end) acc += depth_[k] * sources_[source_[k]];
+        int64_t out = base_[destination] + (acc >> 15);
+        if (out > INT16_MAX) return INT16_MAX;
+        if (out < INT16_MIN) return INT16_MIN;
+        return static_cast<int16_t>(out);
+    }
+
+    size_t connections() const { return count_; }
+
+private:
+    static constexpr size_t DEST_WORDS = (Destinations + 31) / 32;
+
+    void markDirty(uint8_t destination) { dirty_[destination / 32] |= 1u << (destination % 32); }
+
+    // Connections, SoA, sorted by destination
+    int16_t depth_[MaxConnections] = {};
+    uint8_t source_[MaxConnections] = {};
+    uint16_t begin_[Destinations + 1] = {};
+    size_t count_ = 0;
+
+    int16_t sources_[Sources] = {};
+    int16_t base_[Destinations] = {};
+    uint32_t affects_[Sources][DEST_WORDS] = {};
+    uint32_t dirty_[DEST_WORDS] = {};
+};
+
+}  // namespace minimal::param
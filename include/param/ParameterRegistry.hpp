@@ -0,0 +1,244 @@
+#pragma once
+
+/**
+ * @file ParameterRegistry.hpp
+ * @brief Typed parameters between controls and output destinations
+ *
+ * Controls write parameter values; the output stage decides what goes on
+ * the wire. Each parameter has a type, a range, a default, a display name
+ * and up to MAX_DESTINATIONS destinations (MIDI CC, 14-bit CC, OSC).
+ *
+ * Values live in one contiguous array (normalized 0-1). set() marks the
+ * parameter in a dirty bitset only when its output code changes (7-bit if
+ * every destination is a 7-bit CC, 14-bit otherwise), so a tick that does
+ * not move the sent value costs nothing downstream. emit() walks only the
+ * dirty bits and hands every destination of every changed parameter to
+ * one sink: a single batched emission path for all output protocols.
+ *
+ * @code
+ * constexpr ParamSpec SPECS[] = {
+ *     ParamSpec::continuous("Cutoff", 20.0f, 20000.0f, 1000.0f, Destination::cc(0, 16)),
+ *     ParamSpec::stepped("Wave", 4, 0, Destination::cc(0, 19)),
+ * };
+ * ParameterRegistry<2> params(SPECS);
+ * params.set(0, 0.5f);     // from a binding
+ * params.emit(sink);       // once per frame: sink.controlChange(), sink.osc()
+ * @endcode
+ *
+ * A Sink provides:
+ *   void controlChange(uint8_t channel, uint8_t number, uint8_t value);
+ *   void osc(const char* address, float value);   // scaled to min..max
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace minimal::param {
+
+enum class ParamType : uint8_t {
+    Continuous,  ///< float in min..max
+    Stepped,     ///< one of `steps` values (enum, waveform, ...)
+    Toggle       ///< off / on
+};
+
+struct Destination {
+    enum class Kind : uint8_t { None, ControlChange, ControlChange14, Osc };
+
+    Kind kind = Kind::None;
+    uint8_t channel = 0;
+    uint8_t number = 0;
+    const char* address = nullptr;
+
+    static constexpr Destination cc(uint8_t channel, uint8_t number) {
+        return {Kind::ControlChange, channel, number, nullptr};
+    }
+
+    /// MSB on @p number, LSB on number + 32
+    static constexpr Destination cc14(uint8_t channel, uint8_t number) {
+        return {Kind::ControlChange14, channel, number, nullptr};
+    }
+
+    static constexpr Destination osc(const char* address) {
+        return {Kind::Osc, 0, 0, address};
+    }
+};
+
+struct ParamSpec {
+    static constexpr size_t MAX_DESTINATIONS = 2;
+
+    const char* name = "";
+    ParamType type = ParamType::Continuous;
+    float min = 0.0f;
+    float max = 1.0f;
+    float defaultValue = 0.0f;  ///< in min..max
+    uint8_t steps = 0;          ///< Stepped only
+    Destination destinations[MAX_DESTINATIONS] = {};
+
+    static constexpr ParamSpec continuous(const char* name, float min, float max, float def,
+                                          Destination d0, Destination d1 = {}) {
+        return {name, ParamType::Continuous, min, max, def, 0, {d0, d1}};
+    }
+
+    static constexpr ParamSpec stepped(const char* name, uint8_t steps, uint8_t def,
+                                       Destination d0, Destination d1 = {}) {
+        return {name, ParamType::Stepped, 0.0f, static_cast<float>(steps - 1),
+                static_cast<float>(def), steps, {d0, d1}};
+    }
+
+    static constexpr ParamSpec toggle(const char* name, bool def, Destination d0,
+                                      Destination d1 = {}) {
+        return {name, ParamType::Toggle, 0.0f, 1.0f, def ? 1.0f : 0.0f, 2, {d0, d1}};
+    }
+
+    /// True if every destination is a 7-bit CC (dirty tracking at 7 bits)
+    constexpr bool sevenBitOnly() const {
+        for (const auto& d : destinations) {
+            if (d.kind != Destination::Kind::ControlChange && d.kind != Destination::Kind::None) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+template <size_t N>
+class ParameterRegistry {
+    static_assert(N > 0, "empty registry");
+
+public:
+    using ID = uint8_t;
+    static_assert(N <= 0xFF, "parameter IDs are 8-bit");
+
+    /// Starts at the defaults, nothing dirty
+    explicit ParameterRegistry(const ParamSpec (&specs)[N]) : specs_(specs) { loadDefaults(); }
+
+    /// All parameters back to their defaults (marked dirty)
+    void reset() {
+        loadDefaults();
+        markAllDirty();
+    }
+
+    /**
+     * @brief Set a normalized value (clamped, snapped to the type's steps)
+     * @return true if the output code changed (parameter is now dirty)
+     */
+    bool set(ID id, float normalized) {
+        if (normalized < 0.0f) normalized = 0.0f;
+        if (normalized > 1.0f) normalized = 1.0f;
+        const ParamSpec& s = specs_[id];
+        values_[id] = quantizeToType(s, normalized);
+        uint16_t c = code(id, values_[id]);
+        if (c == codes_[id]) return false;
+        codes_[id] = c;
+        dirty_[id / 32] |= 1u << (id % 32);
+        return true;
+    }
+
+    /// Stepped / toggle parameters: set by step index
+    bool setStep(ID id, uint8_t step) {
+        uint8_t last = specs_[id].steps > 1 ? specs_[id].steps - 1 : 1;
+        return set(id, static_cast<float>(step) / static_cast<float>(last));
+    }
+
+    float normalized(ID id) const { return values_[id]; }
+    float value(ID id) const { return specs_[id].min + values_[id] * (specs_[id].max - specs_[id].min); }
+    uint8_t step(ID id) const { return static_cast<uint8_t>(value(id) + 0.5f); }
+    bool on(ID id) const { return values_[id] >= 0.5f; }
+
+    const ParamSpec& spec(ID id) const { return specs_[id]; }
+    static constexpr size_t size() { return N; }
+
+    bool dirty() const {
+        for (uint32_t word : dirty_) {
+            if (word) return true;
+        }
+        return false;
+    }
+
+    /// Re-send everything on the next emit() (e.g. after reconnect or restore)
+    void markAllDirty() {
+        for (ID id = 0; id < N; ++id) dirty_[id / 32] |= 1u << (id % 32);
+    }
+
+    /// Forget pending changes (values were loaded, not changed by the user)
+    void clearDirty() {
+        for (uint32_t& word : dirty_) word = 0;
+    }
+
+    /**
+     * @brief Send every destination of every dirty parameter, then clear
+     * @return number of parameters emitted
+     */
+    template <typename Sink>
+    size_t emit(Sink& sink) {
+        size_t emitted = 0;
+        for (size_t w = 0; w < WORDS; ++w) {
+            uint32_t bits = dirty_[w];
+            dirty_[w] = 0;
+            while (bits) {
+                ID id = static_cast<ID>(w * 32 + __builtin_ctz(bits));
+                bits &= bits - 1;
+                emitOne(sink, id);
+                ++emitted;
+            }
+        }
+        return emitted;
+    }
+
+private:
+    static constexpr size_t WORDS = (N + 31) / 32;
+
+    void loadDefaults() {
+        for (ID id = 0; id < N; ++id) {
+            const ParamSpec& s = specs_[id];
+            float range = s.max - s.min;
+            float v = range > 0.0f ? (s.defaultValue - s.min) / range : 0.0f;
+            values_[id] = quantizeToType(s, v);
+            codes_[id] = code(id, values_[id]);
+        }
+    }
+
+    static float quantizeToType(const ParamSpec& s, float v) {
+        if (s.type == ParamType::Continuous || s.steps < 2) return v;
+        float last = static_cast<float>(s.steps - 1);
+        return static_cast<float>(static_cast<uint32_t>(v * last + 0.5f)) / last;
+    }
+
+    /// Output code at the parameter's resolution: 0-127 or 0-16383
+    uint16_t code(ID id, float v) const {
+        uint16_t max = specs_[id].sevenBitOnly() ? 127 : 16383;
+        return static_cast<uint16_t>(v * static_cast<float>(max) + 0.5f);
+    }
+
+    template <typename Sink>
+    void emitOne(Sink& sink, ID id) {
+        const ParamSpec& s = specs_[id];
+        float v = values_[id];
+        for (const Destination& d : s.destinations) {
+            switch (d.kind) {
+                case Destination::Kind::None:
+                    break;
+                case Destination::Kind::ControlChange:
+                    sink.controlChange(d.channel, d.number,
+                                       static_cast<uint8_t>(v * 127.0f + 0.5f));
+                    break;
+                case Destination::Kind::ControlChange14: {
+                    uint16_t c = static_cast<uint16_t>(v * 16383.0f + 0.5f);
+                    sink.controlChange(d.channel, d.number, static_cast<uint8_t>(c >> 7));
+                    sink.controlChange(d.channel, d.number + 32, static_cast<uint8_t>(c & 0x7F));
+                    break;
+                }
+                case Destination::Kind::Osc:
+                    sink.osc(d.address, value(id));
+                    break;
+            }
+        }
+    }
+
+    const ParamSpec (&specs_)[N];
+    float values_[N];
+    uint16_t codes_[N];
+    uint32_t dirty_[WORDS] = {};
+};
+
+}  // namespace minimal::param
@@ -0,0 +1,145 @@
+#pragma once
+
+/**
+ * @file UndoHistory.hpp
+ * @brief Bounded undo/redo ring of coalesced parameter edits
+ *
+ * Every control change is recorded as (id, before, after). Consecutive
+ * changes to the same parameter within a coalesce window extend the newest
+ * entry instead of adding one, so a sweep over a knob is one undo step.
+ * A sweep that ends where it started removes its entry.
+ *
+ * Values are 16-bit codes (normalized × 65535): an entry is 6 bytes and
+ * the whole history is a fixed array. When the ring is full the oldest
+ * entry is overwritten. Recording is a compare and a couple of stores;
+ * the history keeps each parameter's last value itself, so callers pass
+ * only the new one.
+ *
+ * @code
+ * UndoHistory<PARAM_COUNT, 32> history(1000);
+ * history.baseline(id, value);             // at boot / after restore: not an edit
+ * history.record(id, value, millis());     // from the binding
+ * Edit e;
+ * if (history.undo(e)) apply(e.id, e.before);
+ * if (history.redo(e)) apply(e.id, e.after);
+ * @endcode
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace minimal::param {
+
+struct Edit {
+    uint8_t id = 0;
+    uint16_t before = 0;
+    uint16_t after = 0;
+};
+
+/// Normalized 0-1 to the 16-bit code stored in the history
+inline uint16_t toEditCode(float normalized) {
+    if (normalized <= 0.0f) return 0;
+    if (normalized >= 1.0f) return 0xFFFF;
+    return static_cast<uint16_t>(normalized * 65535.0f + 0.5f);
+}
+
+inline float fromEditCode(uint16_t code) { return static_cast<float>(code) * (1.0f / 65535.0f); }
+
+template <size_t Params, size_t Capacity>
+class UndoHistory {
+    static_assert(Params <= 0xFF, "parameter IDs are 8-bit");
+    static_assert(Capacity > 0, "empty history");
+
+public:
+    /// @param coalesceMs changes to one parameter closer than this merge
+    explicit UndoHistory(uint32_t coalesceMs) : coalesceMs_(coalesceMs) {}
+
+    /// Set a parameter's current value without recording an edit
+    void baseline(uint8_t id, uint16_t value) { last_[id] = value; }
+
+    /**
+     * @brief Record a control change
+     * @return true if a new entry was added (false: merged, dropped or no change)
+     */
+    bool record(uint8_t id, uint16_t value, uint32_t nowMs) {
+        uint16_t before = last_[id];
+        if (value == before) return false;
+        last_[id] = value;
+
+        if (open_ && undoable_ > 0 && newest().id == id && nowMs - lastMs_ < coalesceMs_) {
+            lastMs_ = nowMs;
+            Edit& e = newest();
+            e.after = value;
+            // Back where the gesture started: nothing to undo
+            if (e.after == e.before) pop();
+            return false;
+        }
+
+        entries_[head_] = {id, before, value};
+        head_ = next(head_);
+        if (undoable_ < Capacity) ++undoable_;
+        redoable_ = 0;  // a new edit forks history: the undone branch is gone
+        open_ = true;
+        lastMs_ = nowMs;
+        return true;
+    }
+
+    /// Step back: @p out is the undone edit, restore out.before
+    bool undo(Edit& out) {
+        if (undoable_ == 0) return false;
+        head_ = prev(head_);
+        out = entries_[head_];
+        --undoable_;
+        ++redoable_;
+        last_[out.id] = out.before;
+        open_ = false;
+        return true;
+    }
+
+    /// Step forward again: @p out is the redone edit, restore out.after
+    bool redo(Edit& out) {
+        if (redoable_ == 0) return false;
+        out = entries_[head_];
+        head_ = next(head_);
+        ++undoable_;
+        --redoable_;
+        last_[out.id] = out.after;
+        open_ = false;
+        return true;
+    }
+
+    /// Close the newest entry: the next change starts a new one
+    void seal() { open_ = false; }
+
+    void clear() {
+        undoable_ = redoable_ = 0;
+        open_ = false;
+    }
+
+    size_t undoable() const { return undoable_; }
+    size_t redoable() const { return redoable_; }
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    static size_t next(size_t i) { return i + 1 == Capacity ? 0 : i + 1; }
+    static size_t prev(size_t i) { return i == 0 ? Capacity - 1 : i - 1; }
+
+    Edit& newest() { return entries_[prev(head_)]; }
+
+    void pop() {
+        head_ = prev(head_);
+        --undoable_;
+        open_ = false;
+    }
+
+    Edit entries_[Capacity];
+    uint16_t last_[Params] = {};
+    size_t head_ = 0;       ///< next write (first redoable entry)
+    size_t undoable_ = 0;
+    size_t redoable_ = 0;
+    uint32_t lastMs_ = 0;
+    uint32_t coalesceMs_;
+    bool open_ = false;     ///< newest entry may still be extended
+};
+
+}  // namespace minimal::param
@@ -0,0 +1,62 @@
+#pragma once
+
+/**
+ * @file PcSampler.hpp
+ * @brief On-device PC sampling for profile-guided code placement
+ *
+ * Built only with -D OC_PROFILE (see [env:profile] in platformio.ini).
+ * GPT1 interrupts at SAMPLE_HZ; a naked handler reads the interrupted PC
+ * from the exception frame and bumps a bin in one of two histograms:
+ * ITCM (0x00000000, 32-byte bins) and FlexSPI flash (0x60000000, 64-byte
+ * bins). Bins live in DMAMEM so they do not eat into ITCM/DTCM.
+ *
+ * Every DUMP_PERIOD_MS, loop() prints the non-zero bins and clears them,
+ * so each dump covers only the samples since the previous one:
+ *
+ *   PGO <hex address> <count>
+ *   PGO END <total samples> outside=<samples in neither region>
+ *
+ * scripts/pgo_collect.py maps them to symbols and writes
+ * profile/hot_functions.txt, which scripts/hotcold_ld.py turns into a
+ * linker script for [env:dev] and [env:release].
+ *
+ * Without OC_PROFILE every function is an empty inline.
+ * Implementation: src/profile/PcSampler.cpp
+ */
+
+#include <cstdint>
+
+#include <Arduino.h>
+
+namespace minimal::profile {
+
+/// Sampling rate (prime, so it does not beat against 1 kHz USB frames)
+constexpr uint32_t SAMPLE_HZ = 9973;
+
+/// Interval between histogram dumps over serial
+constexpr uint32_t DUMP_PERIOD_MS = 10000;
+
+#if defined(OC_PROFILE) && defined(__IMXRT1062__)
+
+/// Start GPT1 sampling (call once from setup())
+void begin();
+
+/// Print the histogram over serial (blocking, profiling builds only)
+void dump();
+
+/// Call from loop(): dumps every DUMP_PERIOD_MS
+inline void dumpIfDue() {
+    static uint32_t last = 0;
+    if (millis() - last < DUMP_PERIOD_MS) return;
+    last = millis();
+    dump();
+}
+
+#else
+
+inline void begin() {}
+inline void dumpIfDue() {}
+
+#endif
+
+}  // namespace minimal::profile
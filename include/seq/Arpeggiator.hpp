@@ -0,0 +1,234 @@
+#pragma once
+
+/**
+ * @file Arpeggiator.hpp
+ * @brief Clock-driven arpeggiator over a fixed-capacity held-note set
+ *
+ * Held notes are kept twice: sorted by pitch (up / down / up-down / random)
+ * and in the order they were pressed (as played). Inserting or removing a
+ * note is linear in the capacity; it only happens on key events. A step is
+ * constant time: the position in the pattern maps to (note, octave) with
+ * one division, whatever the mode.
+ *
+ * tick() is called once per 24 PPQN clock tick (seq/Clock.hpp) and plays a
+ * step every DIVISIONS[rate] ticks. The note-off is scheduled in µs at gate ×
+ * step length and sent by poll(), which runs every loop; at gate 1.0 notes
+ * are tied (the next note-on goes out before the previous note-off).
+ *
+ * @code
+ * Arpeggiator<16> arp(channel);
+ * arp.press(60, 100);                    // from a note button / incoming note
+ * while (ticks--) arp.tick(now, clock.tickUs(), out);
+ * arp.poll(now, out);                    // due note-offs
+ * onEncoder(id).turn().then(stream<float>().relative(rate).then(arp.rateControl()));
+ * @endcode
+ *
+ * A Sink provides:
+ *   void noteOn(uint8_t channel, uint8_t note, uint8_t velocity);
+ *   void noteOff(uint8_t channel, uint8_t note);
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include "seq/Clock.hpp"
+
+namespace minimal::seq {
+
+enum class ArpMode : uint8_t { Up, Down, UpDown, Random, AsPlayed };
+
+template <size_t Capacity = 16>
+class Arpeggiator {
+    static_assert(Capacity > 0 && Capacity <= 0x7F, "note capacity out of range");
+
+public:
+    static constexpr uint8_t MAX_OCTAVES = 4;
+
+    /// Callable for a binding: normalized 0-1 → rate index (slow → fast)
+    struct RateControl {
+        Arpeggiator* arp;
+        void operator()(float value) const {
+            arp->setRate(static_cast<uint8_t>(value * static_cast<float>(DIVISION_COUNT - 1) + 0.5f));
+        }
+    };
+
+    /// Callable for a binding: normalized 0-1 → gate length
+    struct GateControl {
+        Arpeggiator* arp;
+        void operator()(float value) const { arp->setGate(value); }
+    };
+
+    explicit Arpeggiator(uint8_t channel) : channel_(channel) {}
+
+    RateControl rateControl() { return {this}; }
+    GateControl gateControl() { return {this}; }
+
+    // ── Held notes ──
+
+    /// @return false if the note is already held or the set is full
+    bool press(uint8_t note, uint8_t velocity) {
+        if (count_ == Capacity || indexOf(note) >= 0) return false;
+        size_t at = count_;
+        while (at > 0 && sorted_[at - 1].pitch > note) {
+            sorted_[at] = sorted_[at - 1];
+            --at;
+        }
+        sorted_[at] = {note, velocity};
+        played_[count_] = {note, velocity};
+        ++count_;
+        return true;
+    }
+
+    bool release(uint8_t note) {
+        int found = indexOf(note);
+        if (found < 0) return false;
+        for (size_t k = static_cast<size_t>(found); k + 1 < count_; ++k) sorted_[k] = sorted_[k + 1];
+        size_t p = 0;
+        while (played_[p].pitch != note) ++p;
+        for (; p + 1 < count_; ++p) played_[p] = played_[p + 1];
+        --count_;
+        return true;
+    }
+
+    void releaseAll() { count_ = 0; }
+    size_t held() const { return count_; }
+
+    // ── Settings ──
+
+    void setMode(ArpMode mode) { mode_ = mode; }
+    ArpMode mode() const { return mode_; }
+
+    void setOctaves(uint8_t octaves) {
+        octaves_ = octaves < 1 ? 1 : octaves > MAX_OCTAVES ? MAX_OCTAVES : octaves;
+    }
+
+    void setRate(uint8_t index) { rate_ = index < DIVISION_COUNT ? index : DIVISION_COUNT - 1; }
+    const Division& rate() const { return DIVISIONS[rate_]; }
+
+    /// Fraction of the step the note sounds (0.05-1.0; 1.0 ties notes)
+    void setGate(float gate) { gate_ = gate < 0.05f ? 0.05f : gate > 1.0f ? 1.0f : gate; }
+    float gate() const { return gate_; }
+
+    // ── Running ──
+
+    /**
+     * @brief One clock tick; plays a step on rate boundaries
+     * @param tickUs current clock tick period (note-off timing)
+     */
+    template <typename Sink>
+    void tick(uint32_t nowUs, uint32_t tickUs, Sink& out) {
+        if (tickCount_ != 0) {
+            if (++tickCount_ >= DIVISIONS[rate_].ticks) tickCount_ = 0;
+            return;
+        }
+        ++tickCount_;
+        if (count_ == 0) {
+            if (sounding_ != NONE) noteOff(out);  // a tied note has no scheduled off
+            position_ = 0;
+            return;
+        }
+        uint8_t previous = sounding_;
+        uint8_t note = nextNote();
+        bool tie = gate_ >= 1.0f && previous != NONE && previous != note;
+        if (previous != NONE && !tie) out.noteOff(channel_, previous);
+        out.noteOn(channel_, note, velocity_);
+        if (tie) out.noteOff(channel_, previous);
+        sounding_ = note;
+        offScheduled_ = gate_ < 1.0f;
+        uint32_t stepUs = tickUs * DIVISIONS[rate_].ticks;
+        offAtUs_ = nowUs + static_cast<uint32_t>(static_cast<float>(stepUs) * gate_);
+    }
+
+    /// Send the note-off when due; call every loop while running
+    template <typename Sink>
+    void poll(uint32_t nowUs, Sink& out) {
+        if (!offScheduled_ || static_cast<int32_t>(nowUs - offAtUs_) < 0) return;
+        noteOff(out);
+    }
+
+    /// Silence and rewind (transport stop, disable)
+    template <typename Sink>
+    void stop(Sink& out) {
+        if (sounding_ != NONE) noteOff(out);
+        position_ = 0;
+        tickCount_ = 0;
+    }
+
+    /// True while a note is sounding (its note-off is still to come)
+    bool sounding() const { return sounding_ != NONE; }
+
+private:
+    struct Note {
+        uint8_t pitch;
+        uint8_t velocity;
+    };
+
+    static constexpr uint8_t NONE = 0xFF;
+
+    int indexOf(uint8_t note) const {
+        for (size_t k = 0; k < count_; ++k) {
+            if (sorted_[k].pitch == note) return static_cast<int>(k);
+        }
+        return -1;
+    }
+
+    template <typename Sink>
+    void noteOff(Sink& out) {
+        out.noteOff(channel_, sounding_);
+        sounding_ = NONE;
+        offScheduled_ = false;
+    }
+
+    /// Pattern position → note; advances the position
+    uint8_t nextNote() {
+        const size_t length = count_ * octaves_;
+        size_t period = length;
+        if (mode_ == ArpMode::UpDown && length > 1) period = 2 * length - 2;
+        if (position_ >= period) position_ = 0;  // notes were released
+
+        size_t k = position_;
+        switch (mode_) {
+            case ArpMode::Up:
+            case ArpMode::AsPlayed:
+                break;
+            case ArpMode::Down:
+                k = length - 1 - k;
+                break;
+            case ArpMode::UpDown:
+                if (k >= length) k = period - k;
+                break;
+            case ArpMode::Random:
+                random_ ^= random_ << 13;
+                random_ ^= random_ >> 17;
+                random_ ^= random_ << 5;
+                k = random_ % length;
+                break;
+        }
+        if (++position_ >= period) position_ = 0;
+
+        const Note& n = mode_ == ArpMode::AsPlayed ? played_[k % count_] : sorted_[k % count_];
+        uint32_t pitch = n.pitch + 12u * static_cast<uint32_t>(k / count_);
+        velocity_ = n.velocity;
+        return static_cast<uint8_t>(pitch > 127 ? n.pitch : pitch);
+    }
+
+    Note sorted_[Capacity] = {};
+    Note played_[Capacity] = {};
+    size_t count_ = 0;
+
+    size_t position_ = 0;
+    uint8_t tickCount_ = 0;
+    uint8_t sounding_ = NONE;
+    uint8_t velocity_ = 0;
+    bool offScheduled_ = false;
+    uint32_t offAtUs_ = 0;
+    uint32_t random_ = 0x2545F491;
+
+    uint8_t channel_;
+    ArpMode mode_ = ArpMode::Up;
+    uint8_t octaves_ = 1;
+    uint8_t rate_ = 6;  ///< 1/16
+    float gate_ = 0.5f;
+};
+
+}  // namespace minimal::seq
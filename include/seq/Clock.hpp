@@ -0,0 +1,138 @@
+#pragma once
+
+/**
+ * @file Clock.hpp
+ * @brief 24 PPQN tempo clock: internal (BPM) or slaved to MIDI clock
+ *
+ * poll() returns how many clock ticks are due since the last call, so a
+ * consumer advances by exact ticks however late the loop gets to it.
+ * Internally the tick period is kept in 1/256 µs and accumulated, so the
+ * tempo does not drift over long runs. Slaved, each incoming 0xF8 is one
+ * tick and the period is tracked from their spacing (for gate lengths).
+ *
+ * @code
+ * Clock clock(120.0f);
+ * uint32_t ticks = clock.poll(micros());
+ * while (ticks--) arp.tick(now, clock.tickUs(), out);
+ * @endcode
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+namespace minimal::seq {
+
+/// Note length in clock ticks (24 PPQN)
+struct Division {
+    uint8_t ticks;
+    const char* name;
+};
+
+/// Rates for arpeggio steps and note repeat, slowest first
+inline constexpr Division DIVISIONS[] = {
+    {96, "1/1"}, {48, "1/2"}, {24, "1/4"}, {16, "1/4T"}, {12, "1/8"},
+    {8, "1/8T"}, {6, "1/16"}, {4, "1/16T"}, {3, "1/32"},
+};
+
+inline constexpr size_t DIVISION_COUNT = sizeof(DIVISIONS) / sizeof(DIVISIONS[0]);
+
+class Clock {
+public:
+    static constexpr uint32_t PPQN = 24;
+
+    /// Ticks handed out per poll() at most (a stalled loop does not burst)
+    static constexpr uint32_t MAX_CATCH_UP = 4;
+
+    explicit Clock(float bpm) { setTempo(bpm); }
+
+    /// Internal tempo (ignored while slaved)
+    void setTempo(float bpm) {
+        if (bpm < 20.0f) bpm = 20.0f;
+        if (bpm > 300.0f) bpm = 300.0f;
+        periodQ8_ = static_cast<uint32_t>(60.0f * 1000000.0f * 256.0f / (bpm * PPQN));
+        if (!external_) tickUs_ = periodQ8_ >> 8;
+    }
+
+    /// Follow incoming MIDI clock instead of the internal tempo
+    void setExternal(bool external) {
+        external_ = external;
+        pending_ = 0;
+        if (!external_) tickUs_ = periodQ8_ >> 8;
+    }
+
+    bool external() const { return external_; }
+
+    /// Start from the next poll(); tick 0 is due immediately
+    void start(uint32_t nowUs) {
+        running_ = true;
+        nextUs_ = nowUs;
+        fracQ8_ = 0;
+        pending_ = 0;
+    }
+
+    void stop() { running_ = false; }
+    bool running() const { return running_; }
+
+    // ── MIDI realtime (slaved) ──
+
+    void onMidiClock(uint32_t nowUs) {
+        if (!external_) return;
+        if (lastPulseUs_ != 0) {
+            uint32_t interval = nowUs - lastPulseUs_;
+            // EMA, 1/8 weight: host clocks jitter by a USB frame
+            tickUs_ = tickUs_ ? (tickUs_ * 7 + interval) / 8 : interval;
+        }
+        lastPulseUs_ = nowUs ? nowUs : 1;
+        if (running_ && pending_ < MAX_CATCH_UP) ++pending_;
+    }
+
+    void onMidiStart(uint32_t nowUs) {
+        if (!external_) return;
+        start(nowUs);
+    }
+
+    void onMidiStop() {
+        if (external_) stop();
+    }
+
+    /// Clock ticks due at @p nowUs
+    uint32_t poll(uint32_t nowUs) {
+        if (!running_) return 0;
+        if (external_) {
+            uint32_t n = pending_;
+            pending_ = 0;
+            return n;
+        }
+        uint32_t n = 0;
+        while (static_cast<int32_t>(nowUs - nextUs_) >= 0 && n < MAX_CATCH_UP) {
+            fracQ8_ += periodQ8_;
+            nextUs_ += fracQ8_ >> 8;
+            fracQ8_ &= 0xFF;
+            ++n;
+        }
+        // Far behind (debugger, long stall): resync instead of catching up
+        if (static_cast<int32_t>(nowUs - nextUs_) >= 0) nextUs_ = nowUs + (periodQ8_ >> 8);
+        return n;
+    }
+
+    /// Current tick period in µs
+    uint32_t tickUs() const { return tickUs_; }
+
+    /// Length of @p division at the current tempo (sub-µs exact when internal)
+    uint32_t divisionUs(const Division& division) const {
+        if (external_) return tickUs_ * division.ticks;
+        return (periodQ8_ * division.ticks) >> 8;
+    }
+
+private:
+    uint32_t periodQ8_ = 0;
+    uint32_t tickUs_ = 0;
+    uint32_t nextUs_ = 0;
+    uint32_t fracQ8_ = 0;
+    uint32_t lastPulseUs_ = 0;
+    uint32_t pending_ = 0;
+    bool external_ = false;
+    bool running_ = false;
+};
+
+}  // namespace minimal::seq
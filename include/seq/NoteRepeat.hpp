@@ -0,0 +1,204 @@
+#pragma once
+
+/**
+ * @file NoteRepeat.hpp
+ * @brief Note repeat / ratchet: held pads retrigger from a hardware timer
+ *
+ * A held pad plays once at press, then again every interval (a clock
+ * division at the current tempo) for as long as it is held. Retriggers are
+ * sent from a PIT interrupt (IntervalTimer), not from loop(): their timing
+ * does not depend on how long the loop pass takes (display, logging,
+ * flash writes).
+ *
+ * The interrupt writes to USB through usbOut.writeFromIsr(), which never
+ * waits inside the interrupt. A hit is deferred to loop() while loop() is
+ * inside a usbOut write or the host has not yet taken earlier TX data, and
+ * dropped while output is held (disconnected or stalled host). The timer
+ * runs at the default priority, below the USB controller's interrupt, so it
+ * never preempts the core's own TX handling.
+ *
+ * Held notes are a 128-bit mask: loop() sets and clears bits, the
+ * interrupt only reads them, so no critical section is needed. Velocity is
+ * read at every retrigger, so it can follow an encoder or analog input
+ * while the pad is held.
+ *
+ * Jitter: every interrupt compares its cycle counter against the ideal
+ * grid (previous ideal time + interval). Hits that went out from the
+ * interrupt record the deviation in `seq.repeat.jitter.ns`; this is the
+ * scheduling error on the device, the host's USB polling adds its own frame
+ * quantization on top. Hits deferred to loop() count as `seq.repeat.late`,
+ * hits that lost packets as `seq.repeat.dropped`: their real timing is not
+ * known at the interrupt.
+ *
+ * @code
+ * NoteRepeat repeat(channel);
+ * repeat.setInterval(DIVISIONS[6].ticks * clock.tickUs());   // 1/16
+ * onButton(pad).press().then([&] { repeat.press(36); });
+ * onButton(pad).release().then([&] { repeat.release(36); });
+ * @endcode
+ */
+
+#include <cstdint>
+
+#include <Arduino.h>
+
+#include "metrics/Metrics.hpp"
+#include "metrics/StandardMetrics.hpp"
+#include "midi/OutputQueue.hpp"
+#include "midi/PackedMessage.hpp"
+
+namespace minimal::seq {
+
+class NoteRepeat {
+public:
+    /// Callable for a binding: normalized 0-1 → velocity 1-127
+    struct VelocityControl {
+        NoteRepeat* repeat;
+        void operator()(float value) const {
+            repeat->setVelocity(static_cast<uint8_t>(1.0f + value * 126.0f + 0.5f));
+        }
+    };
+
+    explicit NoteRepeat(uint8_t channel) : channel_(channel) {}
+
+    VelocityControl velocityControl() { return {this}; }
+
+    void setVelocity(uint8_t velocity) {
+        velocity_ = velocity < 1 ? 1 : velocity > 127 ? 127 : velocity;
+    }
+    uint8_t velocity() const { return velocity_; }
+
+    /// Retrigger interval; a running repeat takes it from its next hit (phase kept)
+    void setInterval(uint32_t intervalUs) {
+        if (intervalUs < MIN_INTERVAL_US) intervalUs = MIN_INTERVAL_US;
+        if (intervalUs == intervalUs_) return;
+        intervalUs_ = intervalUs;
+#if defined(__IMXRT1062__)
+        if (running_) {
+            timer_.update(intervalUs);
+            resync_ = true;  // the period in progress still has the old length
+        }
+#endif
+    }
+
+    uint32_t intervalUs() const { return intervalUs_; }
+
+    /// Pad down: first hit now, repeats from the timer while held
+    void press(uint8_t note) {
+        note &= 0x7F;
+        if (held(note)) return;
+        uint32_t on = midi::packUsbMidi(midi::Cin::NoteOn, channel_, note, velocity_);
+        midi::usbOut.write(on);
+        midi::usbOut.flush();
+        metrics::standard::midiOut.inc();
+        held_[note >> 5] = held_[note >> 5] | (1u << (note & 31));
+        if (!running_) start();
+    }
+
+    /// Pad up: stop repeating it and send its note-off
+    void release(uint8_t note) {
+        note &= 0x7F;
+        if (!held(note)) return;
+        held_[note >> 5] = held_[note >> 5] & ~(1u << (note & 31));
+        midi::usbOut.write(midi::packUsbMidi(midi::Cin::NoteOff, channel_, note, 0));
+        midi::usbOut.flush();
+        metrics::standard::midiOut.inc();
+        if (!anyHeld()) stop();
+    }
+
+    bool held(uint8_t note) const { return (held_[(note & 0x7F) >> 5] >> (note & 31)) & 1u; }
+    bool running() const { return running_; }
+
+    static metrics::HistogramBase& jitter() { return jitter_; }
+
+private:
+    /// Max notes retriggered per hit (note-off + note-on each)
+    static constexpr uint8_t MAX_NOTES = 8;
+
+    /// 1/32 at 300 BPM is 25 ms; anything much shorter is a configuration error
+    static constexpr uint32_t MIN_INTERVAL_US = 1000;
+
+    bool anyHeld() const { return (held_[0] | held_[1] | held_[2] | held_[3]) != 0; }
+
+    void start() {
+        running_ = true;
+#if defined(__IMXRT1062__)
+        instance_ = this;
+        resync_ = false;
+        ideal_ = ARM_DWT_CYCCNT;  // the first hit (just sent) is the grid origin
+        timer_.begin(&NoteRepeat::onTimer, intervalUs_);
+#endif
+    }
+
+    void stop() {
+        running_ = false;
+#if defined(__IMXRT1062__)
+        timer_.end();
+        instance_ = nullptr;
+#endif
+    }
+
+#if defined(__IMXRT1062__)
+    static void onTimer() {
+        NoteRepeat* self = instance_;
+        if (self) self->retrigger();
+    }
+
+    void retrigger() {
+        uint32_t now = ARM_DWT_CYCCNT;
+        uint32_t cyclesPerUs = F_CPU_ACTUAL / 1000000;
+        uint32_t interval = intervalUs_ * cyclesPerUs;
+        bool onGrid = !resync_;
+        uint32_t errorNs = 0;
+        if (resync_) {
+            // First hit after a rate change (old period length): new grid reference
+            resync_ = false;
+        } else {
+            int32_t error = static_cast<int32_t>(now - (ideal_ + interval));
+            uint32_t magnitude = static_cast<uint32_t>(error < 0 ? -error : error);
+            errorNs = magnitude * 1000 / cyclesPerUs;
+            now = ideal_ + interval;  // stay on the grid, do not accumulate entry latency
+        }
+        ideal_ = now;
+
+        uint32_t words[2 * MAX_NOTES];
+        uint8_t count = 0;
+        uint8_t velocity = velocity_;
+        for (uint8_t w = 0; w < 4; ++w) {
+            uint32_t bits = held_[w];
+            while (bits && count < 2 * MAX_NOTES) {
+                auto note = static_cast<uint8_t>(w * 32 + __builtin_ctz(bits));
+                bits &= bits - 1;
+                words[count++] = midi::packUsbMidi(midi::Cin::NoteOff, channel_, note, 0);
+                words[count++] = midi::packUsbMidi(midi::Cin::NoteOn, channel_, note, velocity);
+            }
+        }
+        if (!count) return;
+        switch (midi::usbOut.writeFromIsr(words, count)) {
+            case midi::IsrWrite::Sent:
+                if (onGrid) jitter_.record(errorNs);
+                break;
+            case midi::IsrWrite::Deferred: late_.inc(); break;
+            case midi::IsrWrite::Dropped: dropped_.inc(); break;
+        }
+    }
+
+    inline static NoteRepeat* instance_ = nullptr;
+    inline static IntervalTimer timer_;
+    uint32_t ideal_ = 0;
+    volatile bool resync_ = true;
+#endif
+
+    inline static constexpr uint32_t JITTER_NS_BOUNDS[] = {250, 500, 1000, 2000, 5000, 10000, 50000};
+    inline static metrics::Histogram<7> jitter_{"seq.repeat.jitter.ns", JITTER_NS_BOUNDS};
+    inline static metrics::Counter late_{"seq.repeat.late"};
+    inline static metrics::Counter dropped_{"seq.repeat.dropped"};
+
+    volatile uint32_t held_[4] = {};
+    volatile uint8_t velocity_ = 100;
+    volatile uint32_t intervalUs_ = 125000;
+    uint8_t channel_;
+    bool running_ = false;
+};
+
+}  // namespace minimal::seq
@@ -0,0 +1,197 @@
+#pragma once
+
+/**
+ * @file FlashJournal.hpp
+ * @brief Wear-leveled, append-only journal of fixed-size state records
+ *
+ * Every write appends one record after the previous one, cycling through
+ * all sectors of the region, so each sector is erased once per
+ * (sector size / record size) writes. A sector is erased only when the
+ * write position enters it.
+ *
+ * Record: [magic][sequence][payload][crc32], padded to a power of two.
+ * The newest valid record (highest sequence, good CRC) wins. A torn write
+ * (power lost mid-program) fails its CRC and is skipped.
+ *
+ * restore() reads memory-mapped flash and never copies a sector: with two
+ * sectors and 32-byte records it checks 256 magic words, a few µs at boot.
+ *
+ * prepare() erases ahead, so the next write only programs one record. That
+ * write, appendPrepared(), has a fixed worst-case time (WORST_CASE_APPEND_US)
+ * and is what a power-fail handler uses. Erasing ahead needs at least two
+ * sectors (the newest record must never sit in the sector being erased).
+ *
+ * @code
+ * FlashJournal<State, TeensyFlashRegion> journal({0x607BE000, 2});
+ * State s;
+ * if (!journal.restore(s)) s = State{};
+ * ...
+ * journal.append(s);   // blocking: program (<1 ms) or erase + program
+ * @endcode
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#include "storage/Crc32.hpp"
+#include "storage/FlashRegion.hpp"
+
+namespace minimal::storage {
+
+template <typename Payload, typename Region>
+class FlashJournal {
+    static_assert(std::is_trivially_copyable_v<Payload>, "Payload must be trivially copyable");
+
+    static constexpr uint32_t MAGIC = 0x4A524E31;  // "JRN1"
+
+    struct Record {
+        uint32_t magic;
+        uint32_t sequence;
+        Payload payload;
+        uint32_t crc;
+    };
+
+    static constexpr uint32_t recordSize() {
+        uint32_t size = 16;
+        while (size < sizeof(Record)) size <<= 1;
+        return size;
+    }
+
+public:
+    static constexpr uint32_t RECORD_SIZE = recordSize();
+    static_assert(RECORD_SIZE <= SECTOR_SIZE, "Payload too large for one sector");
+
+    /// Upper bound for appendPrepared(): one page program + CRC/copy
+    static constexpr uint32_t WORST_CASE_APPEND_US =
+        timing::programUs(RECORD_SIZE) + timing::RECORD_OVERHEAD_US;
+
+    explicit FlashJournal(Region region) : region_(region) {}
+
+    /**
+     * @brief Find the newest valid record and position the write pointer
+     * @return false if the region holds no valid record (first boot)
+     */
+    bool restore(Payload& out) {
+        const Record* newest = nullptr;
+        uint32_t newestOffset = 0;
+        for (uint32_t offset = 0; offset < region_.size(); offset += RECORD_SIZE) {
+            const Record* r = reinterpret_cast<const Record*>(region_.data(offset));
+            if (r->magic != MAGIC || !valid(*r)) continue;
+            if (!newest || static_cast<int32_t>(r->sequence - newest->sequence) > 0) {
+                newest = r;
+                newestOffset = offset;
+            }
+        }
+        if (!newest) {
+            writeOffset_ = 0;
+            sequence_ = 0;
+            return false;
+        }
+        std::memcpy(&out, &newest->payload, sizeof(Payload));
+        sequence_ = newest->sequence;
+        writeOffset_ = next(newestOffset);
+        return true;
+    }
+
+    /// Append a record (blocking; erases a sector when entering it)
+    void append(const Payload& payload) {
+        writing_ = true;
+        writeOffset_ = erasedSlotFrom(writeOffset_);
+        write(payload);
+        writing_ = false;
+    }
+
+    /**
+     * @brief Erase ahead so the next append only programs (call when idle)
+     *
+     * No-op on a single-sector region, where erasing ahead would destroy the
+     * newest record.
+     */
+    void prepare() {
+        if (region_.size() < 2 * SECTOR_SIZE) return;
+        writing_ = true;
+        writeOffset_ = erasedSlotFrom(writeOffset_);
+        writing_ = false;
+    }
+
+    /// True if the next append needs no erase
+    bool ready() const { return erased(writeOffset_, RECORD_SIZE); }
+
+    /**
+     * @brief Bounded-time append into the pre-erased slot (ISR-safe)
+     * @return false if the slot is not erased or a write is in progress
+     *         (interrupted append()/prepare()); nothing is written then
+     *
+     * An interrupt that arrives while loop() is inside append() or
+     * prepare() (including right after an erase, which itself runs with
+     * interrupts disabled) backs off: the interrupted call still owns the
+     * write position. The caller decides what that means for its data.
+     */
+    bool appendPrepared(const Payload& payload) {
+        if (writing_) return false;
+        // Claim first, then check: an interrupting appendPrepared() that ran
+        // before the claim has moved the write position, ready() sees it
+        writing_ = true;
+        bool ok = ready();
+        if (ok) write(payload);
+        writing_ = false;
+        return ok;
+    }
+
+    /// True while append(), prepare() or appendPrepared() holds the write position
+    bool writing() const { return writing_; }
+
+    uint32_t sequence() const { return sequence_; }
+    Region& region() { return region_; }
+
+private:
+    static bool valid(const Record& r) { return crc32(&r, offsetof(Record, crc)) == r.crc; }
+
+    /// First programmable slot at or after @p offset (erases on sector entry)
+    uint32_t erasedSlotFrom(uint32_t offset) {
+        for (uint32_t tries = 0; tries < region_.size() / RECORD_SIZE; ++tries) {
+            if (offset % SECTOR_SIZE == 0 && !erased(offset, SECTOR_SIZE)) {
+                region_.eraseSector(offset);
+            }
+            if (erased(offset, RECORD_SIZE)) break;
+            offset = next(offset);  // torn record from a previous power loss
+        }
+        return offset;
+    }
+
+    void write(const Payload& payload) {
+        uint32_t offset = writeOffset_;
+        alignas(4) uint8_t buffer[RECORD_SIZE];
+        std::memset(buffer, 0xFF, sizeof(buffer));
+        Record record;
+        record.magic = MAGIC;
+        record.sequence = ++sequence_;
+        record.payload = payload;
+        record.crc = crc32(&record, offsetof(Record, crc));
+        std::memcpy(buffer, &record, sizeof(record));
+        region_.program(offset, buffer, RECORD_SIZE);
+        writeOffset_ = next(offset);
+    }
+
+    uint32_t next(uint32_t offset) const {
+        offset += RECORD_SIZE;
+        return offset >= region_.size() ? 0 : offset;
+    }
+
+    bool erased(uint32_t offset, uint32_t length) const {
+        const uint32_t* words = reinterpret_cast<const uint32_t*>(region_.data(offset));
+        for (uint32_t i = 0; i < length / 4; ++i) {
+            if (words[i] != 0xFFFFFFFF) return false;
+        }
+        return true;
+    }
+
+    Region region_;
+    uint32_t writeOffset_ = 0;
+    uint32_t sequence_ = 0;
+    volatile bool writing_ = false;
+};
+
+}  // namespace minimal::storage
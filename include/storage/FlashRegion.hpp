@@ -0,0 +1,132 @@
+#pragma once
+
+/**
+ * @file FlashRegion.hpp
+ * @brief Raw access to a reserved range of sectors in program flash
+ *
+ * TeensyFlashRegion reads through the FlexSPI memory map (no copy, a few
+ * ns per word) and programs/erases with the Teensy core's EEPROM-emulation
+ * primitives. Those run from RAM with interrupts disabled for the duration
+ * of the flash operation: a 4 KB erase blocks for tens of milliseconds, a
+ * small program for well under one.
+ *
+ * RamFlashRegion has the same interface over a RAM array, with NOR
+ * semantics (erase = 0xFF, program can only clear bits). It backs host
+ * builds and lets storage code be exercised off-target; it also accumulates
+ * the worst-case device time of every operation (timing::), so a host run
+ * reports what the same sequence could cost on the chip
+ * (test/test_storage prints it for the largest record sizes).
+ *
+ * Layout (Teensy 4.1, 8 MB flash): the EEPROM emulation occupies the top
+ * of flash from 0x607C0000. The example reserves the sectors just below it:
+ *
+ *   0x607BE000  2 sectors  state journal   (storage/FlashJournal.hpp)
+ *
+ * The stock linker script lets the program image grow up to 0x607C0000;
+ * scripts/hotcold_ld.py ends its FLASH region at STATE_JOURNAL_ADDRESS and
+ * fails the link if _flashimagelen reaches the journal. Builds without
+ * that script must keep the image below it themselves.
+ *
+ * Do not combine with LittleFS_Program, which allocates from the same end.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__IMXRT1062__)
+#include <Arduino.h>
+#endif
+
+namespace minimal::storage {
+
+constexpr uint32_t SECTOR_SIZE = 4096;
+
+/// Worst-case QSPI NOR timings (W25Q64JV on Teensy 4.1, datasheet maxima)
+namespace timing {
+
+constexpr uint32_t PAGE_SIZE = 256;
+constexpr uint32_t PAGE_PROGRAM_MAX_US = 3000;
+constexpr uint32_t SECTOR_ERASE_MAX_US = 400000;
+
+/// Command setup, CRC and buffer copy for one small record at 600 MHz
+constexpr uint32_t RECORD_OVERHEAD_US = 50;
+
+/// Programming @p length bytes starting page-aligned (records never straddle pages)
+constexpr uint32_t programUs(uint32_t length) {
+    return ((length + PAGE_SIZE - 1) / PAGE_SIZE) * PAGE_PROGRAM_MAX_US;
+}
+
+}  // namespace timing
+
+#if defined(__IMXRT1062__)
+
+extern "C" {
+void eepromemu_flash_write(void* addr, const void* data, uint32_t len);
+void eepromemu_flash_erase_sector(void* addr);
+}
+
+class TeensyFlashRegion {
+public:
+    constexpr TeensyFlashRegion(uint32_t baseAddress, uint32_t sectorCount)
+        : base_(baseAddress), sectors_(sectorCount) {}
+
+    uint32_t size() const { return sectors_ * SECTOR_SIZE; }
+    const uint8_t* data(uint32_t offset) const {
+        return reinterpret_cast<const uint8_t*>(base_ + offset);
+    }
+
+    void program(uint32_t offset, const void* src, uint32_t length) {
+        eepromemu_flash_write(reinterpret_cast<void*>(base_ + offset), src, length);
+        arm_dcache_delete(reinterpret_cast<void*>((base_ + offset) & ~31u), length + 32);
+    }
+
+    void eraseSector(uint32_t offset) {
+        uint32_t sector = base_ + (offset & ~(SECTOR_SIZE - 1));
+        eepromemu_flash_erase_sector(reinterpret_cast<void*>(sector));
+        arm_dcache_delete(reinterpret_cast<void*>(sector), SECTOR_SIZE);
+    }
+
+private:
+    uint32_t base_;
+    uint32_t sectors_;
+};
+
+#endif
+
+template <uint32_t Sectors>
+class RamFlashRegion {
+public:
+    RamFlashRegion() { std::memset(bytes_, 0xFF, sizeof(bytes_)); }
+
+    uint32_t size() const { return Sectors * SECTOR_SIZE; }
+    const uint8_t* data(uint32_t offset) const { return bytes_ + offset; }
+
+    void program(uint32_t offset, const void* src, uint32_t length) {
+        const uint8_t* s = static_cast<const uint8_t*>(src);
+        for (uint32_t i = 0; i < length; ++i) bytes_[offset + i] &= s[i];
+        programmedBytes += length;
+        lastOperationUs = timing::programUs(length);
+        busyUs += lastOperationUs;
+    }
+
+    void eraseSector(uint32_t offset) {
+        std::memset(bytes_ + (offset & ~(SECTOR_SIZE - 1)), 0xFF, SECTOR_SIZE);
+        ++erasedSectors;
+        lastOperationUs = timing::SECTOR_ERASE_MAX_US;
+        busyUs += lastOperationUs;
+    }
+
+    /// Operation counters, for wear and timing estimates
+    uint32_t programmedBytes = 0;
+    uint32_t erasedSectors = 0;
+
+    /// Simulated worst-case device time: last operation and running total
+    uint32_t lastOperationUs = 0;
+    uint64_t busyUs = 0;
+
+private:
+    uint8_t bytes_[Sectors * SECTOR_SIZE];
+};
+
+}  // namespace minimal::storage
@@ -0,0 +1,106 @@
+#pragma once
+
+/**
+ * @file PowerFail.hpp
+ * @brief Early warning of supply loss, for a last bounded-time state write
+ *
+ * Two sources, either or both:
+ * - a digital pin driven LOW by a supply monitor (comparator / supervisor
+ *   on VIN, set above the regulator's dropout): pin interrupt, µs latency
+ * - loss of USB VBUS (bus-powered controllers): the OTG "B session valid"
+ *   bit, polled from a PIT timer every POLL_US
+ *
+ * The handler runs in interrupt context, once per supply loss. It must only
+ * do bounded work: FlashJournal::appendPrepared() into a pre-erased slot.
+ * The time available is the hold-up time of the bulk capacitance,
+ * t = C · ΔV / I (e.g. 470 µF, 5.0 → 3.6 V, 100 mA ≈ 6.5 ms).
+ *
+ * The latch re-arms when VBUS (and the pin) are good again, so unplugging
+ * an externally powered controller costs one extra record, nothing more.
+ *
+ * A power-fail during a sector erase is not caught: the erase runs with
+ * interrupts disabled. Erasing ahead at idle time keeps that window rare.
+ */
+
+#include <cstdint>
+
+#include <Arduino.h>
+
+namespace minimal::storage {
+
+class PowerFail {
+public:
+    static constexpr uint8_t NO_PIN = 0xFF;
+    static constexpr uint32_t POLL_US = 100;
+
+    using Handler = void (*)(void* ctx);
+
+    /**
+     * @param pin supply monitor input (LOW = failing), or NO_PIN
+     * @param watchVbus also treat loss of USB VBUS as power failure
+     */
+    static void begin(uint8_t pin, bool watchVbus, Handler fn, void* ctx) {
+        fn_ = fn;
+        ctx_ = ctx;
+        pin_ = pin;
+        watchVbus_ = watchVbus;
+#if defined(__IMXRT1062__)
+        if (pin != NO_PIN) {
+            pinMode(pin, INPUT);
+            attachInterrupt(pin, &PowerFail::onPin, FALLING);
+        }
+        if (watchVbus) timer_.begin(&PowerFail::onPoll, POLL_US);
+#endif
+    }
+
+    /// True once the handler has run for the current supply loss
+    static bool triggered() { return triggered_; }
+
+private:
+    static void fire() {
+        if (triggered_) return;
+        triggered_ = true;
+        if (fn_) fn_(ctx_);
+    }
+
+    static bool vbusPresent() {
+#if defined(__IMXRT1062__)
+        return (USB1_OTGSC & OTGSC_BSV) != 0;
+#else
+        return true;
+#endif
+    }
+
+    static bool supplyGood() {
+#if defined(__IMXRT1062__)
+        bool pinGood = pin_ == NO_PIN || digitalReadFast(pin_);
+#else
+        bool pinGood = true;
+#endif
+        return pinGood && (!watchVbus_ || vbusPresent());
+    }
+
+    static void onPin() { fire(); }
+
+    static void onPoll() {
+        if (!vbusPresent()) {
+            fire();
+        } else if (triggered_ && supplyGood()) {
+            triggered_ = false;
+        }
+    }
+
+    /// USB1_OTGSC: B-session valid (VBUS above the session threshold)
+    static constexpr uint32_t OTGSC_BSV = 1u << 11;
+
+    inline static Handler fn_ = nullptr;
+    inline static void* ctx_ = nullptr;
+    inline static uint8_t pin_ = NO_PIN;
+    inline static bool watchVbus_ = false;
+    inline static volatile bool triggered_ = false;
+#if defined(__IMXRT1062__)
+    inline static IntervalTimer timer_;
+#endif
+};
+
+}  // namespace minimal::storage
@@ -0,0 +1,44 @@
+#pragma once
+
+/**
+ * @file WriteCoalescer.hpp
+ * @brief Decides when a burst of state changes should be persisted
+ *
+ * Each change calls touch(). due() becomes true once the state has been
+ * quiet for quietMs, or maxDelayMs after the first unsaved change, so an
+ * encoder sweep costs one flash write instead of hundreds.
+ */
+
+#include <cstdint>
+
+namespace minimal::storage {
+
+class WriteCoalescer {
+public:
+    constexpr WriteCoalescer(uint32_t quietMs, uint32_t maxDelayMs)
+        : quietMs_(quietMs), maxDelayMs_(maxDelayMs) {}
+
+    void touch(uint32_t nowMs) {
+        if (!dirty_) firstChangeMs_ = nowMs;
+        lastChangeMs_ = nowMs;
+        dirty_ = true;
+    }
+
+    bool dirty() const { return dirty_; }
+
+    bool due(uint32_t nowMs) const {
+        return dirty_ &&
+               (nowMs - lastChangeMs_ >= quietMs_ || nowMs - firstChangeMs_ >= maxDelayMs_);
+    }
+
+    void clear() { dirty_ = false; }
+
+private:
+    uint32_t quietMs_;
+    uint32_t maxDelayMs_;
+    uint32_t firstChangeMs_ = 0;
+    uint32_t lastChangeMs_ = 0;
+    bool dirty_ = false;
+};
+
+}  // namespace minimal::storage
@@ -0,0 +1,126 @@
+"""
+PlatformIO post-script: flash reservation and hot/cold code placement
+
+Rewrites the Teensy linker script into the build directory:
+- the FLASH region ends at STATE_JOURNAL_ADDRESS (include/Config.hpp), so
+  the journal sectors below the EEPROM emulation are never part of the
+  program image; an ASSERT on _flashimagelen fails the link otherwise
+- functions in profile/hot_functions.txt go first in ITCM, right after
+  *(.fastrun), so the hot path is contiguous
+- functions in profile/cold_functions.txt go to flash next to
+  *(.flashmem*), freeing ITCM (and therefore RAM1) for hot code and data
+
+Each entry is a (mangled) symbol; with -ffunction-sections it lives in
+section .text.<symbol>. Lines starting with # are ignored. When both lists
+are empty, or the anchors are not found in the stock script, code keeps
+the stock placement.
+"""
+
+import os
+import re
+
+Import("env")  # noqa: F821  (provided by PlatformIO)
+
+ANCHOR_HOT = "*(.fastrun)"
+ANCHOR_COLD = "*(.flashmem*)"
+
+FLASH_REGION = re.compile(
+    r"(FLASH\s*\([A-Za-z!]*\)\s*:\s*ORIGIN\s*=\s*)(0x[0-9A-Fa-f]+|\d+)"
+    r"(\s*,\s*LENGTH\s*=\s*)(0x[0-9A-Fa-f]+|\d+[KM]?)")
+JOURNAL_ADDRESS = re.compile(r"STATE_JOURNAL_ADDRESS\s*=\s*(0x[0-9A-Fa-f]+)")
+
+
+def parse_size(text):
+    scale = {"K": 1024, "M": 1024 * 1024}.get(text[-1], 1)
+    return int(text.rstrip("KM"), 0) * scale
+
+
+def journal_address(project):
+    with open(os.path.join(project, "include", "Config.hpp")) as f:
+        match = JOURNAL_ADDRESS.search(f.read())
+    return int(match.group(1), 16) if match else None
+
+
+def read_list(path):
+    if not os.path.isfile(path):
+        return []
+    names = []
+    with open(path) as f:
+        for line in f:
+            name = line.split("#", 1)[0].strip()
+            if name:
+                names.append(name)
+    return names
+
+
+def inject(script, anchor, names):
+    index = script.find(anchor)
+    if index < 0:
+        return None
+    end = script.index("\n", index)
+    lines = "".join("\n\t\t*(.text.{})".format(n) for n in names)
+    return script[:end] + lines + script[end:]
+
+
+def reserve_journal(script, address):
+    """End FLASH at the journal and assert the image stays below it."""
+    match = FLASH_REGION.search(script)
+    if not match:
+        return None
+    origin = int(match.group(2), 0)
+    length = address - origin
+    if not 0 < length <= parse_size(match.group(4)):
+        return None
+    script = (script[:match.start()] + match.group(1) + match.group(2) + match.group(3) +
+              "0x{:X}".format(length) + script[match.end():])
+    return script + (
+        "\nASSERT(_flashimagelen <= 0x{:X}, \"program image overlaps the state journal "
+        "(STATE_JOURNAL_ADDRESS)\");\n".format(length))
+
+
+def main():
+    project = env.subst("$PROJECT_DIR")  # noqa: F821
+    hot = read_list(os.path.join(project, "profile", "hot_functions.txt"))
+    cold = read_list(os.path.join(project, "profile", "cold_functions.txt"))
+    if not hot and not cold and env.subst("$PIOENV") == "release":  # noqa: F821
+        print("hotcold_ld: WARNING profile/*.txt are empty, release keeps the stock "
+              "layout; capture a profile first (README: Profile-Guided Code Placement)")
+
+    stock = env.subst("$LDSCRIPT_PATH")  # noqa: F821
+    if not os.path.isfile(stock):
+        print("hotcold_ld: WARNING stock linker script not found, state journal "
+              "not reserved")
+        return
+    with open(stock) as f:
+        script = f.read()
+
+    address = journal_address(project)
+    reserved = reserve_journal(script, address) if address is not None else None
+    if reserved:
+        script = reserved
+    else:
+        print("hotcold_ld: WARNING FLASH region or STATE_JOURNAL_ADDRESS not found, "
+              "state journal not reserved")
+
+    placed = script
+    if hot:
+        placed = inject(placed, ANCHOR_HOT, hot)
+    if placed and cold:
+        placed = inject(placed, ANCHOR_COLD, cold)
+    if placed:
+        script = placed
+    else:
+        print("hotcold_ld: anchors not found in {}, stock code placement".format(stock))
+        hot, cold = [], []
+    if not reserved and not hot and not cold:
+        return
+
+    out = os.path.join(env.subst("$BUILD_DIR"), "hotcold.ld")  # noqa: F821
+    with open(out, "w") as f:
+        f.write(script)
+    env.Replace(LDSCRIPT_PATH=out)  # noqa: F821
+    print("hotcold_ld: {} hot, {} cold functions, journal {} -> {}".format(
+        len(hot), len(cold), "reserved" if reserved else "NOT reserved", out))
+
+
+main()
@@ -0,0 +1,86 @@
+"""
+Turn a PcSampler serial capture into profile/hot_functions.txt.
+
+Usage:
+    pio run -e profile -t upload
+    pio device monitor -b 115200 | tee pgo.log     # replay a typical session
+    python scripts/pgo_collect.py --elf .pio/build/profile/firmware.elf pgo.log
+
+Each dump covers the samples since the previous one (the sampler clears
+its bins), so the dumps of a capture are summed. Every "PGO <addr> <count>"
+line is attributed to the function containing <addr>. Functions are ranked by samples and emitted until --coverage of all
+samples is reached. Names are the mangled symbols, which is what
+-ffunction-sections uses for section names (.text.<symbol>).
+"""
+
+import argparse
+import bisect
+import collections
+import subprocess
+import sys
+
+
+def load_symbols(nm, elf):
+    out = subprocess.run([nm, "--defined-only", "-S", elf], check=True,
+                         capture_output=True, text=True).stdout
+    symbols = []
+    for line in out.splitlines():
+        parts = line.split()
+        if len(parts) != 4 or parts[2] not in ("t", "T", "W", "w"):
+            continue
+        symbols.append((int(parts[0], 16), int(parts[1], 16), parts[3]))
+    symbols.sort()
+    return symbols
+
+
+def read_samples(lines):
+    samples = collections.Counter()
+    for line in lines:
+        parts = line.split()
+        if len(parts) == 3 and parts[0] == "PGO" and parts[1] != "END":
+            samples[int(parts[1], 16)] += int(parts[2])
+    return samples
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.split("\n\n")[0])
+    parser.add_argument("capture", nargs="?", help="serial capture (default: stdin)")
+    parser.add_argument("--elf", required=True, help="firmware.elf of the profiled build")
+    parser.add_argument("--nm", default="arm-none-eabi-nm")
+    parser.add_argument("--out", default="profile/hot_functions.txt")
+    parser.add_argument("--coverage", type=float, default=0.95,
+                        help="fraction of samples the hot list must cover")
+    args = parser.parse_args()
+
+    symbols = load_symbols(args.nm, args.elf)
+    starts = [s[0] for s in symbols]
+    with (open(args.capture) if args.capture else sys.stdin) as f:
+        samples = read_samples(f)
+
+    per_function = collections.Counter()
+    for addr, count in samples.items():
+        i = bisect.bisect_right(starts, addr) - 1
+        if i >= 0 and addr < symbols[i][0] + max(symbols[i][1], 1):
+            per_function[symbols[i][2]] += count
+
+    total = sum(per_function.values())
+    if not total:
+        sys.exit("no samples matched symbols in " + args.elf)
+
+    hot, covered = [], 0
+    for name, count in per_function.most_common():
+        if covered >= args.coverage * total:
+            break
+        hot.append((name, count))
+        covered += count
+
+    with open(args.out, "w") as f:
+        f.write("# Generated by scripts/pgo_collect.py - hottest first\n")
+        f.write("# {} functions, {:.1%} of {} samples\n".format(len(hot), covered / total, total))
+        for name, count in hot:
+            f.write("{}  # {}\n".format(name, count))
+    print("wrote {} hot functions to {}".format(len(hot), args.out))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,168 @@
+/**
+ * @file Benchmarks.cpp
+ * @brief Micro-benchmarks printed at boot (OC_BENCH builds only)
+ */
+
+#include "bench/Benchmarks.hpp"
+
+#if defined(OC_BENCH) && defined(__IMXRT1062__)
+
+#include <cstdint>
+
+#include <Arduino.h>
+
+#include "dsp/Kernels.hpp"
+#include "param/ModMatrix.hpp"
+
+namespace minimal::bench {
+
+namespace {
+
+constexpr uint32_t REPEAT = 1000;
+
+/// Deterministic inputs (same numbers on every run)
+struct Lcg {
+    uint32_t state = 12345;
+    uint32_t next() { return state = state * 1664525u + 1013904223u; }
+};
+
+void report(const char* name, uint32_t cycles, uint32_t ops) {
+    Serial.printf("BENCH %s %lu\n", name, static_cast<unsigned long>(cycles / ops));
+}
+
+/// Scalar reference: one multiply per term, no packing
+int32_t scalarSum(const int16_t* depth, const uint8_t* source, const int16_t* values, size_t n) {
+    int64_t acc = 0;
+    for (size_t k = 0; k < n; ++k) acc += depth[k] * values[source[k]];
+    return static_cast<int32_t>(acc >> 15);
+}
+
+// ── Modulation matrix: 256 connections, 32 sources, 64 destinations ──
+
+constexpr size_t MOD_CONNECTIONS = 256;
+constexpr size_t MOD_SOURCES = 32;
+constexpr size_t MOD_DESTINATIONS = 64;
+
+using BenchMatrix = param::ModMatrix<MOD_CONNECTIONS, MOD_SOURCES, MOD_DESTINATIONS>;
+
+BenchMatrix matrix;
+int16_t scalarDepth[MOD_CONNECTIONS];
+uint8_t scalarSource[MOD_CONNECTIONS];
+int16_t scalarValues[MOD_SOURCES];
+
+void benchModMatrix() {
+    Lcg rng;
+    for (size_t k = 0; k < MOD_CONNECTIONS; ++k) {
+        uint8_t source = rng.next() % MOD_SOURCES;
+        uint8_t destination = rng.next() % MOD_DESTINATIONS;
+        float depth = static_cast<float>(static_cast<int32_t>(rng.next() % 2001) - 1000) / 1000.0f;
+        matrix.connect(source, destination, depth);
+        scalarDepth[k] = dsp::toQ15(depth);
+        scalarSource[k] = source;
+    }
+    for (size_t s = 0; s < MOD_SOURCES; ++s) {
+        scalarValues[s] = static_cast<int16_t>(rng.next());
+        matrix.setSource(static_cast<uint8_t>(s), scalarValues[s]);
+    }
+
+    volatile int32_t sink = 0;
+    auto out = [&](uint8_t, int16_t v) { sink = sink + v; };
+
+    // Every destination recomputed (all 256 MACs)
+    uint32_t start = ARM_DWT_CYCCNT;
+    for (uint32_t i = 0; i < REPEAT; ++i) {
+        for (uint8_t d = 0; d < MOD_DESTINATIONS; ++d) sink = sink + matrix.compute(d);
+    }
+    report("modmatrix.full.256", ARM_DWT_CYCCNT - start, REPEAT);
+
+    // Same 256 terms, scalar loop
+    start = ARM_DWT_CYCCNT;
+    for (uint32_t i = 0; i < REPEAT; ++i) {
+        sink = sink + scalarSum(scalarDepth, scalarSource, scalarValues, MOD_CONNECTIONS);
+    }
+    report("modmatrix.scalar.256", ARM_DWT_CYCCNT - start, REPEAT);
+
+    // One source changes: only its destinations are recomputed
+    matrix.evaluate(out);
+    start = ARM_DWT_CYCCNT;
+    for (uint32_t i = 0; i < REPEAT; ++i) {
+        matrix.setSource(i % MOD_SOURCES, static_cast<int16_t>(i));
+        matrix.evaluate(out);
+    }
+    report("modmatrix.one_source.256", ARM_DWT_CYCCNT - start, REPEAT);
+}
+
+// ── Batch kernels: 256 values, against the per-value float path ──
+
+constexpr size_t BATCH = 256;
+
+int16_t batchA[BATCH];
+int16_t batchB[BATCH];
+int16_t batchOut[BATCH];
+float floatA[BATCH];
+float floatB[BATCH];
+float floatOut[BATCH];
+uint8_t codes[BATCH];
+
+void benchKernels() {
+    Lcg rng;
+    for (size_t i = 0; i < BATCH; ++i) {
+        batchA[i] = static_cast<int16_t>(rng.next() & 0x7FFF);
+        batchB[i] = static_cast<int16_t>(rng.next() & 0x7FFF);
+        floatA[i] = dsp::fromQ15(batchA[i]);
+        floatB[i] = dsp::fromQ15(batchB[i]);
+    }
+    volatile uint32_t sink = 0;
+
+    uint32_t start = ARM_DWT_CYCCNT;
+    for (uint32_t i = 0; i < REPEAT; ++i) {
+        for (size_t k = 0; k < BATCH; ++k) {
+            codes[k] = static_cast<uint8_t>(floatA[k] * 127.0f + 0.5f);
+        }
+        sink = sink + codes[i % BATCH];
+    }
+    report("map.midi7.float.256", ARM_DWT_CYCCNT - start, REPEAT);
+
+    start = ARM_DWT_CYCCNT;
+    for (uint32_t i = 0; i < REPEAT; ++i) {
+        dsp::toMidi7(batchA, codes, BATCH);
+        sink = sink + codes[i % BATCH];
+    }
+    report("map.midi7.q15.256", ARM_DWT_CYCCNT - start, REPEAT);
+
+    start = ARM_DWT_CYCCNT;
+    for (uint32_t i = 0; i < REPEAT; ++i) {
+        float t = static_cast<float>(i % 100) / 100.0f;
+        for (size_t k = 0; k < BATCH; ++k) floatOut[k] = floatA[k] + (floatB[k] - floatA[k]) * t;
+        sink = sink + static_cast<uint32_t>(floatOut[i % BATCH] * 127.0f);
+    }
+    report("morph.float.256", ARM_DWT_CYCCNT - start, REPEAT);
+
+    start = ARM_DWT_CYCCNT;
+    for (uint32_t i = 0; i < REPEAT; ++i) {
+        dsp::mix(batchA, batchB, static_cast<int16_t>((i % 100) * 327), batchOut, BATCH);
+        sink = sink + batchOut[i % BATCH];
+    }
+    report("morph.q15.256", ARM_DWT_CYCCNT - start, REPEAT);
+
+    start = ARM_DWT_CYCCNT;
+    for (uint32_t i = 0; i < REPEAT; ++i) {
+        dsp::add(batchA, batchB, batchOut, BATCH);
+        sink = sink + batchOut[i % BATCH];
+    }
+    report("add.q15.256", ARM_DWT_CYCCNT - start, REPEAT);
+}
+
+}  // namespace
+
+void run() {
+    while (!Serial && millis() < 3000) {
+    }
+    benchModMatrix();
+    benchKernels();
+    Serial.println("BENCH END");
+}
+
+}  // namespace minimal::bench
+
+#endif
@@ -7,15 +7,47 @@
  * - Simplified oc::hal::teensy::AppBuilder API
  * - Fluent input binding API (onButton, onEncoder)
  * - MIDI CC output via MidiAPI
+ * - Non-blocking logging from input callbacks (MINIMAL_LOG_*)
+ * - Named metrics (counters, gauges, histograms) readable over serial/SysEx
+ * - Incoming MIDI routing (subscription bitset + perfect hash)
+ * - Hot/cold code placement (FLASHMEM for one-shot setup code)
+ * - Wake-on-demand context updates (ScheduledContext)
+ * - State persisted in a wear-leveled flash journal, restored at boot
+ * - Power-fail snapshot: bounded-time write of unsaved state on supply loss
+ * - MIDI output held (CCs collapsed) while USB is down or the host stalls
+ * - Optional USB frame sync: scan + flush just before each SOF (USB_FRAME_SYNC)
+ * - Parameter registry: controls set parameters, one batched path emits them
+ * - Modulation matrix: LFO / incoming CC → parameters (LFO_DEPTH, MOD_INPUT_DEPTH)
+ * - Undo history: coalesced edits in a bounded ring (UNDO_DEPTH)
+ * - Optional arpeggiator over incoming held notes, internal or MIDI clock (ARP_ENABLED)
+ * - Optional note repeat retriggered from a hardware timer (NOTE_REPEAT_ENABLED)
+ * - Optional Mackie Control surface: V-Pots, MCU buttons, DAW feedback (MCU_ENABLED)
+ * - Optional HID keyboard shortcuts, one report per USB frame (HID_ENABLED)
+ * - Optional motion input: IMU tilt / shake read by timer + DMA I2C (MOTION_ENABLED)
  *
  * Features shown:
- * - Button press → MIDI CC 127
- * - Button release → MIDI CC 0
- * - Button long press → Different action
+ * - Button press → MIDI CC 127 (pre-encoded USB-MIDI packet)
+ * - Button release → MIDI CC 0 (pre-encoded USB-MIDI packet)
+ * - Button 1 long hold, released unused → Dump metrics (serial log + SysEx)
+ * - Button 2 double tap → speculative toggle, undone when a 2nd tap arrives
+ * - Button 1 held + button 2 press → undo the last edit (one knob sweep = one edit)
  * - Encoder turn → MIDI CC (0-127 mapped from 0.0-1.0)
+ * - Optional 14-bit encoder output with sub-tick interpolation (ENCODER_14BIT)
+ * - Button 1 held → fine adjust (encoders 1-3 move at FINE_FACTOR)
+ * - Encoder 4 → discrete steps (e.g. waveform), CC sent only on step change
+ * - Incoming CC on encoder CCs → DAW feedback tracked per encoder
+ * - ARP_ENABLED: held notes arpeggiated, encoders 1/2 → arp rate / gate
+ * - NOTE_REPEAT_ENABLED: button 2 held → note repeat, encoder 3 → its velocity
+ * - MCU_ENABLED: encoders → accelerated V-Pots, buttons → MCU notes (play / stop)
+ * - HID_ENABLED: button 2 → keyboard shortcut (Ctrl+S)
+ * - MOTION_ENABLED: tilt (roll) modulates encoder 1's parameter, shake encoder 2's
+ * - Encoder positions + button 2 toggle survive power cycles; the restored
+ *   state is re-sent as one MIDI burst once USB is enumerated
  *
  * NOTE: Enable -D OC_LOG in platformio.ini build_flags to see debug output.
  *       Remove it for production (zero overhead, instant boot).
+ *       Input callbacks log through MINIMAL_LOG_* (queued, drained in loop())
+ *       so a slow or absent serial host never stalls the input path.
  *
  * Hardware configuration is in Config.hpp - ADAPT pins to your wiring.
  */
@@ -29,6 +61,44 @@
 
 // Local configuration
 #include "Config.hpp"
+#include "context/ScheduledContext.hpp"
+#include "dsp/Lfo.hpp"
+#include "dsp/Simd.hpp"
+#include "hid/HidOutput.hpp"
+#include "log/Log.hpp"
+#include "log/LogLimit.hpp"
+#include "metrics/Metrics.hpp"
+#include "metrics/MetricsReport.hpp"
+#include "metrics/StandardMetrics.hpp"
+#include "midi/FrameSync.hpp"
+#include "midi/IncomingDispatcher.hpp"
+#include "midi/OutputQueue.hpp"
+#include "midi/PackedMessage.hpp"
+#include "midi/UsbConnection.hpp"
+#include "midi/UsbMidiInput.hpp"
+#include "input/Interpolator.hpp"
+#include "input/Modifiers.hpp"
+#include "input/Steps.hpp"
+#include "input/Stream.hpp"
+#include "input/TapArbiter.hpp"
+#include "mcu/Feedback.hpp"
+#include "mcu/Protocol.hpp"
+#include "mcu/VPot.hpp"
+#include "motion/MotionInput.hpp"
+#include "param/ModMatrix.hpp"
+#include "param/ParameterRegistry.hpp"
+#include "param/UndoHistory.hpp"
+#include "bench/Benchmarks.hpp"
+#include "seq/Arpeggiator.hpp"
+#include "seq/Clock.hpp"
+#include "seq/NoteRepeat.hpp"
+#include "profile/PcSampler.hpp"
+#include "storage/FlashJournal.hpp"
+#include "storage/FlashRegion.hpp"
+#include "storage/PowerFail.hpp"
+#include "storage/WriteCoalescer.hpp"
+
+namespace metrics = minimal::metrics;
 
 // ═══════════════════════════════════════════════════════════════════
 // Context ID (user-defined enum)
@@ -36,6 +106,123 @@
 
 enum class ContextID : uint8_t { MINIMAL = 0 };
 
+// ═══════════════════════════════════════════════════════════════════
+// Parameters
+// ═══════════════════════════════════════════════════════════════════
+
+/// Encoder i drives parameter i; button 2 toggles the last one
+enum ParamID : uint8_t {
+    PARAM_ENCODER_1 = 0,
+    PARAM_ENCODER_2,
+    PARAM_ENCODER_3,
+    PARAM_ENCODER_4,
+    PARAM_BUTTON_2,
+    PARAM_COUNT
+};
+
+static_assert(PARAM_BUTTON_2 == Config::ENCODERS.size(), "one parameter per encoder");
+static_assert(!(Config::ARP_ENABLED && Config::NOTE_REPEAT_ENABLED) ||
+                  (Config::NOTE_REPEAT_VELOCITY_ENCODER != Config::ARP_RATE_ENCODER &&
+                   Config::NOTE_REPEAT_VELOCITY_ENCODER != Config::ARP_GATE_ENCODER),
+              "note repeat velocity and arpeggiator share an encoder");
+static_assert(!Config::MCU_ENABLED || (!Config::ARP_ENABLED && !Config::NOTE_REPEAT_ENABLED),
+              "Mackie Control takes over the encoders and buttons");
+static_assert(!Config::MCU_ENABLED || (Config::LFO_DEPTH == 0.0f && Config::MOD_INPUT_DEPTH == 0.0f),
+              "Mackie Control: modulated parameter CCs would land on the V-Pot CCs");
+static_assert(!Config::HID_ENABLED || (!Config::NOTE_REPEAT_ENABLED && !Config::MCU_ENABLED),
+              "the HID shortcut takes button 2");
+static_assert(Config::MOTION_RATE_HZ >= 50 && Config::MOTION_RATE_HZ <= 1000,
+              "IMU rate: one bus transaction takes ~0.45 ms");
+static_assert(Config::MCU_FIRST_STRIP + Config::ENCODERS.size() <= minimal::mcu::STRIPS,
+              "V-Pot strips out of range");
+
+constexpr minimal::param::ParamSpec encoderParam(uint8_t i, const char* name) {
+    using minimal::param::Destination;
+    using minimal::param::ParamSpec;
+    constexpr uint8_t CH = Config::MIDI_CHANNEL;
+    uint8_t cc = Config::ENCODER_CC_BASE + i;
+    if (i == Config::STEPPED_ENCODER_INDEX) {
+        return ParamSpec::stepped(name, Config::STEPPED_ENCODER_STEPS, 0, Destination::cc(CH, cc));
+    }
+    return ParamSpec::continuous(name, 0.0f, 1.0f, 0.0f,
+                                 Config::ENCODER_14BIT ? Destination::cc14(CH, cc)
+                                                       : Destination::cc(CH, cc));
+}
+
+constexpr minimal::param::ParamSpec PARAMS[PARAM_COUNT] = {
+    encoderParam(PARAM_ENCODER_1, "Encoder 1"),
+    encoderParam(PARAM_ENCODER_2, "Encoder 2"),
+    encoderParam(PARAM_ENCODER_3, "Encoder 3"),
+    encoderParam(PARAM_ENCODER_4, "Encoder 4"),
+    minimal::param::ParamSpec::toggle(
+        "Button 2", false,
+        minimal::param::Destination::cc(Config::MIDI_CHANNEL, Config::BUTTON2_CC)),
+};
+
+/// Modulation sources (matrix destinations are ParamIDs)
+enum ModSource : uint8_t {
+    MOD_SRC_LFO = 0,
+    MOD_SRC_INPUT_CC,
+    MOD_SRC_TILT,
+    MOD_SRC_SHAKE,
+    MOD_SOURCE_COUNT
+};
+
+/// Where emitted parameters go: USB-MIDI in batches (no OSC transport here)
+struct OutputSink {
+    minimal::midi::PacketBatch<16> midi;
+
+    void controlChange(uint8_t channel, uint8_t number, uint8_t value) {
+        midi.controlChange(channel, number, value);
+    }
+    void osc(const char*, float) {}
+};
+
+/// Arpeggiator notes: written and flushed one by one, timing before batching
+struct NoteSink {
+    void noteOn(uint8_t channel, uint8_t note, uint8_t velocity) {
+        send(minimal::midi::packUsbMidi(minimal::midi::Cin::NoteOn, channel, note, velocity));
+    }
+    void noteOff(uint8_t channel, uint8_t note) {
+        send(minimal::midi::packUsbMidi(minimal::midi::Cin::NoteOff, channel, note, 0));
+    }
+    static void send(uint32_t word) { minimal::midi::sendBurst(&word, 1); }
+};
+
+// ═══════════════════════════════════════════════════════════════════
+// Persistent State
+// ═══════════════════════════════════════════════════════════════════
+
+/// What survives a power cycle (one journal record, 32 bytes with header)
+struct SavedState {
+    uint16_t positions[Config::ENCODERS.size()];  ///< normalized × 65535
+    uint8_t button2;
+};
+
+#if defined(__IMXRT1062__)
+using StateRegion = minimal::storage::TeensyFlashRegion;
+#else
+using StateRegion = minimal::storage::RamFlashRegion<Config::STATE_JOURNAL_SECTORS>;
+#endif
+
+using StateJournal = minimal::storage::FlashJournal<SavedState, StateRegion>;
+
+static_assert(StateJournal::WORST_CASE_APPEND_US <= Config::POWER_FAIL_HOLDUP_US,
+              "power-fail snapshot does not fit the supply hold-up time");
+
+// ═══════════════════════════════════════════════════════════════════
+// Incoming MIDI Routing
+// ═══════════════════════════════════════════════════════════════════
+
+/// Incoming bindings, filled by contexts at init, fed from loop()
+minimal::midi::IncomingDispatcher<64> midiIn;
+
+/// MIDI clock / transport, set by the context that follows it
+minimal::midi::RealtimeHandler midiRealtime;
+
+/// SysEx (Mackie Control LCD), set by the context that parses it
+minimal::midi::SysExHandler midiSysEx;
+
 // ═══════════════════════════════════════════════════════════════════
 // Minimal Context Implementation
 // ═══════════════════════════════════════════════════════════════════
@@ -44,9 +231,20 @@ enum class ContextID : uint8_t { MINIMAL = 0 };
  * @brief Simple standalone context for MIDI controller
  *
  * Sets up all input bindings during initialization.
- * Encoders send CC, buttons toggle CC values.
+ * Encoders and the button 2 toggle set parameters (PARAMS); tick() emits
+ * the changed ones to their destinations in one batch. Modulated
+ * parameters take the control value as base and get the matrix output.
+ *
+ * tick() only runs when woken: after a parameter change, while a double
+ * tap is pending, a 14-bit glide is in progress, state is waiting to be
+ * saved or the boot resend is waiting for USB. Otherwise the per-loop
+ * update is a flag test.
+ *
+ * Encoder positions are tracked here (relative to the restored value), not
+ * read from the framework, so a restored position does not jump to wherever
+ * the encoder's own counter starts.
  */
-class MinimalContext : public oc::context::ContextBase {
+class MinimalContext : public minimal::context::ScheduledContext<MinimalContext> {
 public:
     /// Declare required APIs (validated at registration time)
     static constexpr oc::context::Requirements REQUIRES{
@@ -55,59 +253,773 @@ public:
         .midi = true
     };
 
-    oc::type::Result<void> init() override {
+    FLASHMEM oc::type::Result<void> init() override {
+        setUpdatePolicy(minimal::context::UpdatePolicy::onWake());
+        restoreState();
+        for (uint8_t id = 0; id < PARAM_COUNT; ++id) {
+            history_.baseline(id, minimal::param::toEditCode(controlValue(id)));
+        }
+        setupModulation();
+        clock_.setExternal(Config::TEMPO_FROM_MIDI_CLOCK);
+        if constexpr (Config::ARP_ENABLED) setupArpeggiator();
+        if constexpr (Config::NOTE_REPEAT_ENABLED) setupNoteRepeat();
+        if constexpr (Config::MOTION_ENABLED) setupMotion();
+        journal_.prepare();  // pre-erase: the next save is a bounded program only
+        minimal::storage::PowerFail::begin(Config::POWER_FAIL_PIN, Config::POWER_FAIL_ON_VBUS_LOSS,
+                                           &MinimalContext::onPowerFail, this);
         setupEncoderBindings();
         setupButtonBindings();
+        setupMidiInBindings();
         return oc::type::Result<void>::ok();
     }
 
-    void update() override {}
+    /// Runs only after wake(); re-arms itself while work is pending
+    void tick() {
+        metrics::standard::contextUpdates.inc();
+        bool busy = button2Tap_.poll(millis());
+        if constexpr (Config::ENCODER_14BIT) busy |= emitInterpolated();
+        if (resendPending_) busy |= resendState();
+        busy |= modulate();
+        if constexpr (Config::ARP_ENABLED) busy |= runArpeggiator();
+        if constexpr (Config::NOTE_REPEAT_ENABLED) busy |= followTempo();
+        if constexpr (Config::MCU_ENABLED) busy |= runMcu();
+        emitParams();
+        busy |= saveStateIfDue();
+        if (busy) wake();
+    }
 
     const char* getName() const override { return "Minimal Controller"; }
 
 private:
-    void setupEncoderBindings() {
-        // Encoder 1-4: Send MIDI CC on turn
-        // Value is normalized [0.0-1.0], we map to [0-127]
+    FLASHMEM void setupEncoderBindings() {
+        if constexpr (Config::MCU_ENABLED) {
+            setupVPots();
+            return;
+        }
+
+        // Encoder 1-4: set parameter i on turn (normalized 0.0-1.0);
+        // PARAMS decides what is sent (CC, 14-bit CC, ...)
         for (uint8_t i = 0; i < Config::ENCODERS.size(); ++i) {
             oc::type::EncoderID id = Config::ENCODERS[i].id;
-            uint8_t cc = Config::ENCODER_CC_BASE + i;
 
-            onEncoder(id).turn().then([this, cc](float value) {
-                uint8_t midiValue = static_cast<uint8_t>(value * 127.0f);
-                midi().sendCC(Config::MIDI_CHANNEL, cc, midiValue);
-                OC_LOG_DEBUG("Encoder: CC {} = {}", cc, midiValue);
-            });
+            if (Config::ARP_ENABLED &&
+                (i == Config::ARP_RATE_ENCODER || i == Config::ARP_GATE_ENCODER)) {
+                setupArpEncoder(id, i);
+                continue;
+            }
+
+            if (Config::NOTE_REPEAT_ENABLED && i == Config::NOTE_REPEAT_VELOCITY_ENCODER) {
+                onEncoder(id).turn().then(minimal::input::stream<float>()
+                                              .relative(positions_[i])
+                                              .then([this](float value) {
+                    repeat_.velocityControl()(value);
+                    stateChanged();
+                }));
+                continue;
+            }
+
+            if (i == Config::STEPPED_ENCODER_INDEX) {
+                setupSteppedEncoder(id, i);
+                continue;
+            }
+
+            // fine: bit test on the modifier mask, no per-binding .when()
+            uint32_t fineMask = (Config::FINE_ENCODER_MASK >> i) & 1u ? FINE : 0u;
+
+            if constexpr (Config::ENCODER_14BIT) {
+                // Ticks only feed the interpolator, tick() sets the parameter
+                onEncoder(id).turn().then(minimal::input::stream<float>()
+                                              .fine(modifiers_, fineMask, Config::FINE_FACTOR,
+                                                    &positions_[i])
+                                              .then([this, i](float value) {
+                    metrics::standard::encoderEvents.inc();
+                    if (modifiers_.test(FINE)) fineUsed_ = true;
+                    interpolators_[i].onTick(value, micros());
+                    history_.record(i, minimal::param::toEditCode(value), millis());
+                    stateChanged();
+                }));
+                continue;
+            }
+
+            // set() is false when the output code did not change: nothing to send
+            onEncoder(id).turn().then(minimal::input::stream<float>()
+                                          .fine(modifiers_, fineMask, Config::FINE_FACTOR,
+                                                &positions_[i])
+                                          .then([this, i](float value) {
+                metrics::standard::encoderEvents.inc();
+                if (modifiers_.test(FINE)) fineUsed_ = true;
+                history_.record(i, minimal::param::toEditCode(value), millis());
+                if (!setParam(i, value)) return;
+                stateChanged();
+                // Fires on every change: cap at 10 lines/s, the rest are summarized
+                MINIMAL_LOG_DEBUG_RATE_PER(i, Config::ENCODERS.size(), 10, "Param: {} = {}",
+                                           PARAMS[i].name, params_.value(i));
+            }));
         }
     }
 
-    void setupButtonBindings() {
-        // Button 1: Press sends CC 127, release sends CC 0
-        onButton(Config::BUTTONS[0].id).press().then([this]() {
-            midi().sendCC(Config::MIDI_CHANNEL, Config::BUTTON1_CC, 127);
-            OC_LOG_DEBUG("Button 1: Press -> CC 127");
-        });
+    FLASHMEM void setupSteppedEncoder(oc::type::EncoderID id, uint8_t param) {
+        // Enumerated parameter: handler runs only when the step changes
+        constexpr uint8_t STEPS = Config::STEPPED_ENCODER_STEPS;
+        onEncoder(id).turn().then(minimal::input::stream<float>()
+                                      .relative(positions_[param])
+                                      .then(minimal::input::steps<STEPS>([this, param](uint8_t step) {
+            metrics::standard::encoderEvents.inc();
+            history_.record(param, minimal::param::toEditCode(positions_[param]), millis());
+            params_.setStep(param, step);
+            stateChanged();
+            MINIMAL_LOG_DEBUG("{}: step {}", PARAMS[param].name, step);
+        })));
+    }
 
-        onButton(Config::BUTTONS[0].id).release().then([this]() {
-            midi().sendCC(Config::MIDI_CHANNEL, Config::BUTTON1_CC, 0);
-            OC_LOG_DEBUG("Button 1: Release -> CC 0");
-        });
+    FLASHMEM void setupArpEncoder(oc::type::EncoderID id, uint8_t i) {
+        // Same relative position as the other encoders (persisted), fed to the arp
+        auto position = minimal::input::stream<float>().relative(positions_[i]);
+        if (i == Config::ARP_RATE_ENCODER) {
+            onEncoder(id).turn().then(position.then([this](float value) {
+                arp_.rateControl()(value);
+                stateChanged();
+                MINIMAL_LOG_DEBUG_ON_CHANGE(arp_.rate().ticks, "Arp: rate {}", arp_.rate().name);
+            }));
+        } else {
+            onEncoder(id).turn().then(position.then([this](float value) {
+                arp_.gateControl()(value);
+                stateChanged();
+                MINIMAL_LOG_DEBUG_RATE(10, "Arp: gate {}", arp_.gate());
+            }));
+        }
+    }
 
-        // Button 1: Long press for alternative action
-        onButton(Config::BUTTONS[0].id).longPress(Config::LONG_PRESS_MS).then([]() {
-            OC_LOG_INFO("Button 1: Long press!");
-        });
+    FLASHMEM void setupButtonBindings() {
+        // Button 1: Held for LONG_PRESS_MS and released without fine-adjusting
+        // or undoing dumps all metrics (serial log + SysEx). Decided on release:
+        // a long hold is also how the modifier is used.
+        auto timeHold = [this]() {
+            metrics::standard::buttonEvents.inc();
+            button1DownMs_ = millis();
+            fineUsed_ = false;
+        };
+        auto dumpOnLongHold = [this]() {
+            metrics::standard::buttonEvents.inc();
+            if (fineUsed_ || millis() - button1DownMs_ < Config::LONG_PRESS_MS) return;
+            MINIMAL_LOG_INFO("Button 1: Long hold -> metrics");
+            metrics::logAll();
+            metrics::sendSysEx(minimal::midi::usbOut);
+        };
+
+        if constexpr (Config::MCU_ENABLED) {
+            // Buttons send MCU notes only. A plain CC on channel 1 would land on
+            // the V-Pot range (CC 16-23), and V-Pots have no fine mode.
+            onButton(Config::BUTTONS[0].id).press().then(timeHold);
+            onButton(Config::BUTTONS[0].id).release().then(dumpOnLongHold);
+            setupMcuButtons();
+            return;
+        }
+
+        // Button 1: Press sends CC 127, release sends CC 0, and holds the
+        // fine-adjust modifier. CC packets are encoded at compile time.
+        static_assert(Config::FINE_BUTTON_INDEX == 0, "fine modifier is wired to button 1");
+        using minimal::input::all;
+        using minimal::midi::sendsCC;
+        onButton(Config::BUTTONS[0].id).press().then(
+            all(modifiers_.holds(FINE), sendsCC<Config::MIDI_CHANNEL, Config::BUTTON1_CC, 127>(),
+                timeHold));
+        onButton(Config::BUTTONS[0].id).release().then(
+            all(modifiers_.releases(FINE), sendsCC<Config::MIDI_CHANNEL, Config::BUTTON1_CC, 0>(),
+                dumpOnLongHold));
+
+        if constexpr (Config::HID_ENABLED) {
+            // Button 2: keyboard shortcut, sent by hid().poll() in the next USB frame
+            onButton(Config::BUTTONS[1].id).press().then([this]() {
+                metrics::standard::buttonEvents.inc();
+                hid().key(Config::HID_BUTTON2_CHORD);
+            });
+            return;
+        }
+
+        if constexpr (Config::NOTE_REPEAT_ENABLED) {
+            // Button 2 is a pad: repeats its note while held (timer interrupt)
+            onButton(Config::BUTTONS[1].id).press().then([this]() {
+                metrics::standard::buttonEvents.inc();
+                repeat_.setInterval(clock_.divisionUs(REPEAT_DIVISION));
+                repeat_.press(Config::NOTE_REPEAT_NOTE);
+                wake();
+            });
+            onButton(Config::BUTTONS[1].id).release().then([this]() {
+                repeat_.release(Config::NOTE_REPEAT_NOTE);
+            });
+            return;
+        }
 
-        // Button 2: Toggle behavior (press sends 127, press again sends 0)
+        // Button 2: Toggle on single tap, CC 22 on double tap.
+        // The toggle fires immediately (speculative); if a second tap
+        // follows within DOUBLE_TAP_MS it is undone before the double action.
+        // With button 1 held, a press undoes the last edit instead.
         onButton(Config::BUTTONS[1].id).press().then([this]() {
-            button2_state_ = !button2_state_;
-            uint8_t value = button2_state_ ? 127 : 0;
-            midi().sendCC(Config::MIDI_CHANNEL, Config::BUTTON2_CC, value);
-            OC_LOG_DEBUG("Button 2: Toggle -> CC {}", value);
+            metrics::standard::buttonEvents.inc();
+            if (modifiers_.test(FINE)) {
+                fineUsed_ = true;
+                undo();
+                return;
+            }
+            button2Tap_.onPress(millis());
+            wake();
         });
     }
 
-    bool button2_state_ = false;
+    static void onButton2Toggle(void* ctx) {
+        auto* self = static_cast<MinimalContext*>(ctx);
+        toggles_.inc();
+        bool on = !self->params_.on(PARAM_BUTTON_2);
+        self->params_.set(PARAM_BUTTON_2, on ? 1.0f : 0.0f);
+        self->history_.record(PARAM_BUTTON_2, on ? 0xFFFF : 0, millis());
+        self->stateChanged();
+        MINIMAL_LOG_DEBUG("Button 2: Toggle -> {}", on ? "on" : "off");
+    }
+
+    static void onButton2Undo(void* ctx) {
+        auto* self = static_cast<MinimalContext*>(ctx);
+        bool on = !self->params_.on(PARAM_BUTTON_2);
+        self->params_.set(PARAM_BUTTON_2, on ? 1.0f : 0.0f);
+        self->history_.record(PARAM_BUTTON_2, on ? 0xFFFF : 0, millis());  // cancels the toggle's entry
+        self->stateChanged();
+        MINIMAL_LOG_DEBUG("Button 2: Toggle undone");
+    }
+
+    static void onButton2DoubleTap(void* ctx) {
+        auto* self = static_cast<MinimalContext*>(ctx);
+        self->emitParams();  // the undone toggle goes out before the double-tap CC
+        self->sendCC(Config::BUTTON2_DOUBLE_CC, 127);
+        self->sendCC(Config::BUTTON2_DOUBLE_CC, 0);
+        MINIMAL_LOG_DEBUG("Button 2: Double tap -> CC {}", Config::BUTTON2_DOUBLE_CC);
+    }
+
+    FLASHMEM void setupMidiInBindings() {
+        // DAW feedback on the encoder CCs: remember the host-side value
+        midiIn.clear();
+        if constexpr (Config::MCU_ENABLED) setupMcuFeedback();
+        for (uint8_t i = 0; i < Config::ENCODERS.size() && !Config::MCU_ENABLED; ++i) {
+            midiIn.subscribe(minimal::midi::MessageType::ControlChange, Config::MIDI_CHANNEL,
+                             Config::ENCODER_CC_BASE + i, {&MinimalContext::onFeedback, this});
+        }
+        if (Config::MOD_INPUT_DEPTH != 0.0f) {
+            midiIn.subscribe(minimal::midi::MessageType::ControlChange, Config::MIDI_CHANNEL,
+                             Config::MOD_INPUT_CC, {&MinimalContext::onModInput, this});
+        }
+        if constexpr (Config::ARP_ENABLED) {
+            using minimal::midi::MessageType;
+            for (uint8_t k = 0; k < Config::ARP_INPUT_NOTE_COUNT; ++k) {
+                uint8_t note = Config::ARP_INPUT_FIRST_NOTE + k;
+                midiIn.subscribe(MessageType::NoteOn, Config::MIDI_CHANNEL, note,
+                                 {&MinimalContext::onArpNoteOn, this});
+                midiIn.subscribe(MessageType::NoteOff, Config::MIDI_CHANNEL, note,
+                                 {&MinimalContext::onArpNoteOff, this});
+            }
+        }
+        if (Config::ARP_ENABLED || Config::NOTE_REPEAT_ENABLED) {
+            midiRealtime = {&MinimalContext::onRealtime, this};
+        }
+        midiIn.rebuild();
+    }
+
+    static void onModInput(void* ctx, uint8_t, uint8_t, uint8_t value) {
+        auto* self = static_cast<MinimalContext*>(ctx);
+        self->mod_.setSource(MOD_SRC_INPUT_CC, static_cast<int16_t>(value << 8));
+        self->wake();
+    }
+
+    // ── Modulation ──────────────────────────────────────────────────
+
+    FLASHMEM void setupModulation() {
+        if (Config::LFO_DEPTH != 0.0f) mod_.connect(MOD_SRC_LFO, PARAM_ENCODER_1, Config::LFO_DEPTH);
+        if (Config::MOD_INPUT_DEPTH != 0.0f) {
+            mod_.connect(MOD_SRC_INPUT_CC, PARAM_ENCODER_2, Config::MOD_INPUT_DEPTH);
+        }
+        if (Config::MOTION_ENABLED && Config::MOTION_TILT_DEPTH != 0.0f) {
+            mod_.connect(MOD_SRC_TILT, PARAM_ENCODER_1, Config::MOTION_TILT_DEPTH);
+        }
+        if (Config::MOTION_ENABLED && Config::MOTION_SHAKE_DEPTH != 0.0f) {
+            mod_.connect(MOD_SRC_SHAKE, PARAM_ENCODER_2, Config::MOTION_SHAKE_DEPTH);
+        }
+        for (uint8_t id = 0; id < PARAM_COUNT; ++id) {
+            mod_.setBase(id, minimal::dsp::toQ15(params_.normalized(id)));
+        }
+        lfoRunning_ = Config::LFO_DEPTH != 0.0f;
+        if (lfoRunning_) wake();
+    }
+
+    /// Motion events arrive from loop() (motionInput.poll()), never from the bus
+    FLASHMEM void setupMotion() {
+        using minimal::motion::Axis;
+        onMotion(Axis::Roll).move().then([this](float v) {
+            mod_.setSource(MOD_SRC_TILT, minimal::dsp::toQ15((v - 0.5f) * 2.0f));  // level = 0
+            wake();
+        });
+        onMotion(Axis::Shake).move().then([this](float v) {
+            mod_.setSource(MOD_SRC_SHAKE, minimal::dsp::toQ15(v));
+            wake();
+        });
+    }
+
+    /// Control value in; modulated parameters go through the matrix
+    bool setParam(uint8_t id, float value) {
+        if (!mod_.modulates(id)) return params_.set(id, value);
+        mod_.setBase(id, minimal::dsp::toQ15(value));
+        return true;
+    }
+
+    /// @return true while the LFO runs (keeps tick() scheduled)
+    bool modulate() {
+        if (lfoRunning_) {
+            uint32_t now = micros();
+            uint32_t elapsed = now - lastModUs_;
+            if (elapsed >= Config::MOD_UPDATE_INTERVAL_US) {
+                lastModUs_ = now;
+                mod_.setSource(MOD_SRC_LFO, lfo_.advance(elapsed));
+            }
+        }
+        if (mod_.dirty()) {
+            mod_.evaluate([this](uint8_t id, int16_t value) {
+                params_.set(id, minimal::dsp::fromQ15(value));
+            });
+        }
+        return lfoRunning_;
+    }
+
+    static void onFeedback(void* ctx, uint8_t, uint8_t cc, uint8_t value) {
+        auto* self = static_cast<MinimalContext*>(ctx);
+        self->feedback_[cc - Config::ENCODER_CC_BASE] = value;
+        MINIMAL_LOG_DEBUG_RATE(10, "Feedback: CC {} = {}", cc, value);
+    }
+
+    /// @return true while any glide is still in progress
+    bool emitInterpolated() {
+        uint32_t now = micros();
+        if (now - lastOutputUs_ < Config::ENCODER_OUTPUT_INTERVAL_US) return true;
+        lastOutputUs_ = now;
+
+        bool gliding = false;
+        for (uint8_t i = 0; i < Config::ENCODERS.size(); ++i) {
+            if (i == Config::STEPPED_ENCODER_INDEX) continue;
+            if (interpolators_[i].sample(now)) setParam(i, interpolators_[i].value());
+            gliding |= interpolators_[i].gliding();
+        }
+        return gliding;
+    }
+
+    /// The one output path: every changed parameter, all destinations, one batch
+    void emitParams() {
+        if (!params_.dirty()) return;
+        params_.emit(output_);
+        output_.midi.flush();
+    }
+
+    // ── Arpeggiator ─────────────────────────────────────────────────
+
+    FLASHMEM void setupArpeggiator() {
+        arp_.setMode(static_cast<minimal::seq::ArpMode>(Config::ARP_MODE));
+        arp_.setOctaves(Config::ARP_OCTAVES);
+        if (!restored_) {
+            // No saved positions: start the rate / gate encoders at the engine defaults
+            positions_[Config::ARP_RATE_ENCODER] =
+                6.0f / static_cast<float>(minimal::seq::DIVISION_COUNT - 1);  // 1/16
+            positions_[Config::ARP_GATE_ENCODER] = 0.5f;
+        }
+        arp_.rateControl()(positions_[Config::ARP_RATE_ENCODER]);
+        arp_.gateControl()(positions_[Config::ARP_GATE_ENCODER]);
+    }
+
+    static void onArpNoteOn(void* ctx, uint8_t channel, uint8_t note, uint8_t velocity) {
+        if (velocity == 0) return onArpNoteOff(ctx, channel, note, velocity);
+        auto* self = static_cast<MinimalContext*>(ctx);
+        self->arp_.press(note, velocity);
+        // Internal clock: the pattern starts on the first held note
+        if (!self->clock_.external() && !self->clock_.running()) self->clock_.start(micros());
+        self->wake();
+    }
+
+    static void onArpNoteOff(void* ctx, uint8_t, uint8_t note, uint8_t) {
+        auto* self = static_cast<MinimalContext*>(ctx);
+        self->arp_.release(note);
+        self->wake();
+    }
+
+    static void onRealtime(void* ctx, uint8_t type) {
+        auto* self = static_cast<MinimalContext*>(ctx);
+        uint32_t now = micros();
+        switch (type) {
+            case 0xF8: self->clock_.onMidiClock(now); break;
+            case 0xFA: self->arp_.stop(self->notes_); self->clock_.onMidiStart(now); break;
+            case 0xFB: self->clock_.onMidiStart(now); break;
+            case 0xFC: self->clock_.onMidiStop(); self->arp_.stop(self->notes_); break;
+            default: return;
+        }
+        self->wake();
+    }
+
+    /// @return true while the clock runs or a note-off is pending
+    bool runArpeggiator() {
+        uint32_t now = micros();
+        for (uint32_t ticks = clock_.poll(now); ticks > 0; --ticks) {
+            arp_.tick(now, clock_.tickUs(), notes_);
+        }
+        arp_.poll(now, notes_);
+        if (!clock_.external() && arp_.held() == 0 && !arp_.sounding()) {
+            clock_.stop();
+            arp_.stop(notes_);
+        }
+        return clock_.running() || arp_.sounding();
+    }
+
+    // ── Note repeat ─────────────────────────────────────────────────
+
+    static constexpr const minimal::seq::Division& REPEAT_DIVISION =
+        minimal::seq::DIVISIONS[Config::NOTE_REPEAT_DIVISION];
+
+    FLASHMEM void setupNoteRepeat() {
+        constexpr uint8_t VELOCITY = Config::NOTE_REPEAT_VELOCITY_ENCODER;
+        if (!restored_) positions_[VELOCITY] = 100.0f / 127.0f;
+        repeat_.velocityControl()(positions_[VELOCITY]);
+        repeat_.setInterval(clock_.divisionUs(REPEAT_DIVISION));
+    }
+
+    /// Slaved to MIDI clock: keep a running repeat on the host's tempo
+    bool followTempo() {
+        if (!repeat_.running() || !clock_.external()) return false;
+        repeat_.setInterval(clock_.divisionUs(REPEAT_DIVISION));
+        return true;
+    }
+
+    // ── Mackie Control ──────────────────────────────────────────────
+
+    FLASHMEM void setupVPots() {
+        // Relative movement → accelerated ticks, summed until tick() sends them
+        for (uint8_t i = 0; i < Config::ENCODERS.size(); ++i) {
+            onEncoder(Config::ENCODERS[i].id).turn().then(minimal::input::stream<float>()
+                                                              .delta()
+                                                              .then([this, i](float delta) {
+                metrics::standard::encoderEvents.inc();
+                float movement = delta * Config::MCU_VPOT_TICKS_PER_RANGE;
+                vpotTicks_[i] = static_cast<int16_t>(vpotTicks_[i] + vpots_[i].ticks(movement, millis()));
+                wake();
+            }));
+        }
+    }
+
+    FLASHMEM void setupMcuButtons() {
+        for (uint8_t b = 0; b < Config::BUTTONS.size(); ++b) {
+            uint8_t note = Config::MCU_BUTTON_NOTES[b];
+            onButton(Config::BUTTONS[b].id).press().then([note]() {
+                metrics::standard::buttonEvents.inc();
+                sendMcuNote(note, 127);
+            });
+            onButton(Config::BUTTONS[b].id).release().then([note]() { sendMcuNote(note, 0); });
+        }
+    }
+
+    FLASHMEM void setupMcuFeedback() {
+        using minimal::midi::MessageType;
+        using namespace minimal::mcu;
+        for (uint8_t s = 0; s < Config::ENCODERS.size(); ++s) {
+            midiIn.subscribe(MessageType::ControlChange, CHANNEL, RING_CC + Config::MCU_FIRST_STRIP + s,
+                             {&MinimalContext::onMcuRing, this});
+        }
+        midiIn.subscribe(MessageType::ChannelPressure, CHANNEL, 0, {&MinimalContext::onMcuMeter, this});
+        for (uint8_t note : Config::MCU_BUTTON_NOTES) {
+            midiIn.subscribe(MessageType::NoteOn, CHANNEL, note, {&MinimalContext::onMcuLed, this});
+            midiIn.subscribe(MessageType::NoteOff, CHANNEL, note, {&MinimalContext::onMcuLed, this});
+        }
+        midiSysEx = {&MinimalContext::onMcuSysEx, this};
+    }
+
+    static void onMcuRing(void* ctx, uint8_t channel, uint8_t cc, uint8_t value) {
+        auto* self = static_cast<MinimalContext*>(ctx);
+        self->mcu_.onChannelMessage(static_cast<uint8_t>(0xB0 | channel), cc, value);
+        self->wake();
+    }
+
+    static void onMcuMeter(void* ctx, uint8_t channel, uint8_t data, uint8_t) {
+        auto* self = static_cast<MinimalContext*>(ctx);
+        self->mcu_.onChannelMessage(static_cast<uint8_t>(0xD0 | channel), data, 0);
+        self->wake();
+    }
+
+    static void onMcuLed(void* ctx, uint8_t channel, uint8_t note, uint8_t velocity) {
+        auto* self = static_cast<MinimalContext*>(ctx);
+        self->mcu_.onChannelMessage(static_cast<uint8_t>(0x90 | channel), note, velocity);
+        self->wake();
+    }
+
+    static void onMcuSysEx(void* ctx, const uint8_t* data, size_t length) {
+        auto* self = static_cast<MinimalContext*>(ctx);
+        if (self->mcu_.onSysEx(data, length)) self->wake();
+    }
+
+    static void sendMcuNote(uint8_t note, uint8_t velocity) {
+        uint32_t word = minimal::midi::packUsbMidi(minimal::midi::Cin::NoteOn, minimal::mcu::CHANNEL,
+                                                   note, velocity);
+        minimal::midi::sendBurst(&word, 1);
+    }
+
+    /**
+     * @brief Send summed V-Pot ticks, follow DAW feedback
+     * @return true while ticks are left over or meters are still falling
+     */
+    bool runMcu() {
+        using namespace minimal::mcu;
+        bool pending = false;
+        for (uint8_t i = 0; i < Config::ENCODERS.size(); ++i) {
+            int ticks = vpotTicks_[i];
+            if (ticks == 0) continue;
+            if (ticks > VPOT_MAX_TICKS) ticks = VPOT_MAX_TICKS;
+            if (ticks < -VPOT_MAX_TICKS) ticks = -VPOT_MAX_TICKS;
+            vpotTicks_[i] = static_cast<int16_t>(vpotTicks_[i] - ticks);
+            pending |= vpotTicks_[i] != 0;
+            output_.midi.controlChange(CHANNEL, VPOT_CC + Config::MCU_FIRST_STRIP + i, encodeVPot(ticks));
+        }
+        output_.midi.flush();
+
+        mcu_.decayMeters(millis());
+        uint32_t changed = mcu_.takeChanges();
+        for (uint8_t i = 0; i < Config::ENCODERS.size(); ++i) {
+            uint8_t strip = Config::MCU_FIRST_STRIP + i;
+            if (changed & (Feedback::CHANGED_RING << strip)) {
+                MINIMAL_LOG_DEBUG_RATE(10, "MCU: V-Pot {} ring {}", strip + 1, mcu_.ringPosition(strip));
+            }
+        }
+        if (changed & (0xFFu * Feedback::CHANGED_LCD)) {
+            MINIMAL_LOG_DEBUG_RATE(2, "MCU: [{}]", mcu_.lcd(0));
+        }
+
+        for (uint8_t s = 0; s < STRIPS; ++s) pending |= mcu_.meter(s) != 0;
+        return pending;
+    }
+
+    // ── Undo ────────────────────────────────────────────────────────
+
+    /// Control-side value of a parameter (what the history records)
+    float controlValue(uint8_t id) const {
+        return id < Config::ENCODERS.size() ? positions_[id] : params_.normalized(id);
+    }
+
+    /// Step back one edit; the restored value goes out with the next emitParams() batch
+    void undo() {
+        minimal::param::Edit edit;
+        if (!history_.undo(edit)) {
+            MINIMAL_LOG_DEBUG("Undo: nothing to undo");
+            return;
+        }
+        applyControl(edit.id, minimal::param::fromEditCode(edit.before));
+        undos_.inc();
+        MINIMAL_LOG_DEBUG("Undo: {} ({} left)", PARAMS[edit.id].name, history_.undoable());
+    }
+
+    /// Set a control from outside its binding (the binding's own state follows)
+    void applyControl(uint8_t id, float value) {
+        if (id >= Config::ENCODERS.size()) {
+            params_.set(id, value);
+        } else {
+            positions_[id] = value;  // binding streams track positions_ by reference
+            if (id == Config::STEPPED_ENCODER_INDEX) {
+                params_.setStep(id, stepAt(value));
+            } else if constexpr (Config::ENCODER_14BIT) {
+                interpolators_[id].jump(value);
+            } else {
+                setParam(id, value);
+            }
+        }
+        stateChanged();
+    }
+
+    /// Step of the stepped encoder at a position (same zones as its binding)
+    static uint8_t stepAt(float position) {
+        minimal::input::StepMapper<Config::STEPPED_ENCODER_STEPS> mapper;
+        mapper.update(position);
+        return mapper.step();
+    }
+
+    // ── Persistence ─────────────────────────────────────────────────
+
+    FLASHMEM void restoreState() {
+        SavedState saved;
+        if (!journal_.restore(saved)) {
+            MINIMAL_LOG_INFO("State: none saved, using defaults");
+            return;
+        }
+        restored_ = true;
+        for (uint8_t i = 0; i < Config::ENCODERS.size(); ++i) {
+            positions_[i] = static_cast<float>(saved.positions[i]) / 65535.0f;
+            if (i == Config::STEPPED_ENCODER_INDEX) {
+                params_.setStep(i, stepAt(positions_[i]));
+            } else {
+                params_.set(i, positions_[i]);
+            }
+        }
+        params_.set(PARAM_BUTTON_2, saved.button2 ? 1.0f : 0.0f);
+        params_.clearDirty();
+        // MCU: the DAW reads channel-1 CCs 16-23 as V-Pot turns, and it owns the
+        // parameter state anyway (it sends ring feedback on connect)
+        resendPending_ = Config::RESEND_STATE_AT_BOOT && !Config::MCU_ENABLED;
+        if (resendPending_) wake();
+        MINIMAL_LOG_INFO("State: restored record {}", journal_.sequence());
+    }
+
+    /// Mark state dirty; the write itself is coalesced in tick()
+    void stateChanged() {
+        saveTimer_.touch(millis());
+        wake();
+    }
+
+    SavedState snapshot() const {
+        SavedState saved{};
+        for (uint8_t i = 0; i < Config::ENCODERS.size(); ++i) {
+            saved.positions[i] = static_cast<uint16_t>(positions_[i] * 65535.0f + 0.5f);
+        }
+        saved.button2 = params_.on(PARAM_BUTTON_2) ? 1 : 0;
+        return saved;
+    }
+
+    /// @return true while unsaved changes are waiting for their write
+    bool saveStateIfDue() {
+        if (!saveTimer_.dirty()) return false;
+        if (!saveTimer_.due(millis())) return true;
+        // Same bounded path as the power-fail write, so its time is measured here
+        uint32_t start = micros();
+        if (journal_.appendPrepared(snapshot())) {
+            snapshotUs_.set(static_cast<int32_t>(micros() - start));
+        } else {
+            journal_.append(snapshot());
+        }
+        saveTimer_.clear();
+        journal_.prepare();
+        MINIMAL_LOG_DEBUG("State: saved record {}", journal_.sequence());
+        return false;
+    }
+
+    /**
+     * Supply is failing (interrupt context): one bounded write, if anything is unsaved
+     *
+     * loop() may be inside the journal. In prepare() (erase ahead) the state
+     * is clean: saveStateIfDue() clears the timer before it, and nothing else
+     * edits state until loop() returns. In the append() fallback, the loop
+     * writes this same snapshot once the interrupt returns. appendPrepared()
+     * backs off in both cases; the miss is counted, the erase is not touched.
+     */
+    static void onPowerFail(void* ctx) {
+        auto* self = static_cast<MinimalContext*>(ctx);
+        if (!self->saveTimer_.dirty()) return;
+        if (self->journal_.appendPrepared(self->snapshot())) {
+            self->saveTimer_.clear();
+        } else {
+            snapshotMissed_.inc();
+        }
+    }
+
+    /**
+     * @brief Send the restored state once the host has configured the device
+     * @return true while still waiting for enumeration or the settle delay
+     */
+    bool resendState() {
+        if (!minimal::midi::usbConfigured()) {
+            configuredAtMs_ = 0;
+            return true;
+        }
+        uint32_t now = millis();
+        if (configuredAtMs_ == 0) configuredAtMs_ = now ? now : 1;
+        if (now - configuredAtMs_ < Config::STATE_RESEND_DELAY_MS) return true;
+
+        params_.markAllDirty();  // sent by emitParams() in this tick
+        resendPending_ = false;
+        MINIMAL_LOG_INFO("State: re-sending {} parameters", params_.size());
+        return false;
+    }
+
+    /// Keyboard / media-key output, alongside midi() (see hid/HidOutput.hpp)
+    minimal::hid::HidOutput& hid() { return minimal::hid::usbHid; }
+
+    /// Tilt / shake bindings, like onEncoder() (see motion/MotionInput.hpp)
+    minimal::motion::MotionInput::Binding onMotion(minimal::motion::Axis axis) {
+        return minimal::motion::motionInput.on(axis);
+    }
+
+    /// Through usbOut: held and collapsed while USB is down or stalled
+    void sendCC(uint8_t cc, uint8_t value) {
+        using minimal::midi::Cin;
+        minimal::midi::usbOut.write(
+            minimal::midi::packUsbMidi(Cin::ControlChange, Config::MIDI_CHANNEL, cc, value));
+        metrics::standard::midiOut.inc();
+    }
+
+    /// Modifier bits
+    static constexpr uint32_t FINE = 1u << 0;
+
+    minimal::input::Modifiers modifiers_;
+    uint32_t button1DownMs_ = 0;
+    bool fineUsed_ = false;  ///< Button 1 served as modifier during this hold
+
+    /// Parameter values + dirty bits, and where emitted values go
+    minimal::param::ParameterRegistry<PARAM_COUNT> params_{PARAMS};
+    OutputSink output_;
+
+    /// Sources → parameters; only destinations with changed inputs are recomputed
+    minimal::param::ModMatrix<16, MOD_SOURCE_COUNT, PARAM_COUNT> mod_;
+    minimal::dsp::Lfo lfo_{Config::LFO_RATE_HZ};
+    uint32_t lastModUs_ = 0;
+    bool lfoRunning_ = false;
+
+    /// Coalesced control edits (fixed ring, 6 bytes per entry)
+    minimal::param::UndoHistory<PARAM_COUNT, Config::UNDO_DEPTH> history_{Config::UNDO_COALESCE_MS};
+
+    /// Single/double tap arbitration for button 2 (Wait / Speculate / SpeculateCompensate)
+    minimal::input::TapArbiter button2Tap_{minimal::input::TapPolicy::SpeculateCompensate,
+                                           Config::DOUBLE_TAP_MS,
+                                           {&MinimalContext::onButton2Toggle, this},
+                                           {&MinimalContext::onButton2DoubleTap, this},
+                                           {&MinimalContext::onButton2Undo, this}};
+
+    /// Sub-tick interpolation state (ENCODER_14BIT only)
+    minimal::input::Interpolator interpolators_[Config::ENCODERS.size()];
+    uint32_t lastOutputUs_ = 0;
+
+    /// Normalized encoder positions (persisted, restored at boot)
+    float positions_[Config::ENCODERS.size()] = {};
+
+    /// Flash journal + write coalescing: a sweep costs one record, not hundreds
+#if defined(__IMXRT1062__)
+    StateJournal journal_{StateRegion(Config::STATE_JOURNAL_ADDRESS, Config::STATE_JOURNAL_SECTORS)};
+#else
+    StateJournal journal_{StateRegion()};
+#endif
+    minimal::storage::WriteCoalescer saveTimer_{Config::STATE_SAVE_QUIET_MS,
+                                                Config::STATE_SAVE_MAX_DELAY_MS};
+    uint32_t configuredAtMs_ = 0;
+    bool resendPending_ = false;
+    bool restored_ = false;
+
+    /// Held notes → arpeggiated notes (ARP_ENABLED only); the clock also sets the repeat rate
+    minimal::seq::Arpeggiator<16> arp_{Config::ARP_OUTPUT_CHANNEL};
+    minimal::seq::Clock clock_{Config::TEMPO_BPM};
+    NoteSink notes_;
+
+    /// Pad retriggers from a PIT interrupt (NOTE_REPEAT_ENABLED only)
+    minimal::seq::NoteRepeat repeat_{Config::NOTE_REPEAT_CHANNEL};
+
+    /// Last value received from the DAW for each encoder CC
+    uint8_t feedback_[Config::ENCODERS.size()] = {};
+
+    /// V-Pot acceleration and ticks not sent yet; DAW feedback (MCU_ENABLED only)
+    minimal::mcu::VPot vpots_[Config::ENCODERS.size()];
+    int16_t vpotTicks_[Config::ENCODERS.size()] = {};
+    minimal::mcu::Feedback mcu_;
+
+    /// Context-specific metric: registers itself, no plumbing needed
+    inline static metrics::Counter toggles_{"minimal.button2.toggles"};
+    inline static metrics::Counter undos_{"minimal.undos"};
+
+    /// Measured time of the bounded (pre-erased) journal write
+    inline static metrics::Gauge snapshotUs_{"minimal.snapshot.us"};
+    /// Power-fail writes that backed off because loop() held the journal
+    inline static metrics::Counter snapshotMissed_{"minimal.snapshot.missed"};
 };
 
 // ═══════════════════════════════════════════════════════════════════
@@ -116,12 +1028,18 @@ private:
 
 std::optional<oc::app::OpenControlApp> app;
 
+/// SOF phase tracking (USB_FRAME_SYNC only)
+minimal::midi::FrameSync frameSync{Config::USB_FRAME_LEAD_US};
+
 // ═══════════════════════════════════════════════════════════════════
 // Arduino Setup
 // ═══════════════════════════════════════════════════════════════════
 
-void setup() {
+// Runs once: kept in flash so ITCM holds only code that runs every loop
+FLASHMEM void setup() {
     OC_LOG_INFO("Minimal Example");
+    minimal::profile::begin();  // no-op unless built with -D OC_PROFILE
+    minimal::bench::run();      // no-op unless built with -D OC_BENCH
 
     app = oc::hal::teensy::AppBuilder()
         .midi()
@@ -135,6 +1053,13 @@ void setup() {
     app->registerContext<MinimalContext>(ContextID::MINIMAL, "Minimal");
     app->begin();
 
+    // Blocking sensor setup happens here, once; afterwards timer + DMA read it
+    if constexpr (Config::MOTION_ENABLED) {
+        if (!minimal::motion::imu.begin(Config::IMU_I2C_ADDRESS, Config::MOTION_RATE_HZ)) {
+            OC_LOG_INFO("No IMU at I2C address {}, motion off", Config::IMU_I2C_ADDRESS);
+        }
+    }
+
     OC_LOG_INFO("Ready");
 }
 
@@ -143,6 +1068,28 @@ void setup() {
 // ═══════════════════════════════════════════════════════════════════
 
 void loop() {
+    if constexpr (Config::USB_FRAME_SYNC) frameSync.waitForSlot();
+    uint32_t start = micros();
+
     // Update the application (polls inputs, processes events, updates context)
     app->update();
+    metrics::standard::loopUs.record(micros() - start);
+
+    // Tilt / shake bindings: reads what the IMU interrupt published, no bus access
+    if constexpr (Config::MOTION_ENABLED) minimal::motion::motionInput.poll();
+
+    // Route incoming MIDI (unsubscribed messages cost one bit test)
+    minimal::midi::pollUsbMidi(midiIn, midiRealtime, midiSysEx);
+
+    // Track USB connection, replay output held during a disconnect or stall
+    minimal::midi::usbOut.poll();
+
+    // Keyboard / media-key reports: at most one each per USB frame
+    minimal::hid::usbHid.poll();
+    if constexpr (Config::USB_FRAME_SYNC) frameSync.flush();
+
+    // Idle time: flush queued log lines without blocking on USB serial
+    minimal::log::drainToSerial();
+    minimal::metrics::logDump.poll();
+    minimal::profile::dumpIfDue();
 }
@@ -0,0 +1,107 @@
+/**
+ * @file PcSampler.cpp
+ * @brief GPT1-driven PC sampler (OC_PROFILE builds only)
+ */
+
+#include "profile/PcSampler.hpp"
+
+#if defined(OC_PROFILE) && defined(__IMXRT1062__)
+
+#include <cstring>
+
+namespace minimal::profile {
+
+namespace {
+
+constexpr uint32_t ITCM_BASE = 0x00000000;
+constexpr uint32_t ITCM_SIZE = 512 * 1024;
+constexpr uint32_t ITCM_SHIFT = 5;
+constexpr uint32_t FLASH_BASE = 0x60000000;
+constexpr uint32_t FLASH_SPAN = 1024 * 1024;
+constexpr uint32_t FLASH_SHIFT = 6;
+
+/// 128 KB of DMAMEM; counts are per dump window, so 32 bits never saturate
+struct Bins {
+    uint32_t itcm[ITCM_SIZE >> ITCM_SHIFT];
+    uint32_t flash[FLASH_SPAN >> FLASH_SHIFT];
+    uint32_t total;
+    uint32_t outside;
+};
+
+DMAMEM Bins bins;
+
+/// GPT1 runs on PERCLK, which the core routes to the 24 MHz oscillator, not the bus clock
+uint32_t perclkHz() {
+    uint32_t source = (CCM_CSCMR1 & CCM_CSCMR1_PERCLK_CLK_SEL) ? 24000000 : F_BUS_ACTUAL;
+    return source / ((CCM_CSCMR1 & CCM_CSCMR1_PERCLK_PODF(0x3F)) + 1);
+}
+
+}  // namespace
+
+}  // namespace minimal::profile
+
+extern "C" __attribute__((used)) void minimalPcSampleRecord(uint32_t pc) {
+    using namespace minimal::profile;
+    GPT1_SR = GPT_SR_OF1;
+    uint32_t* bin = nullptr;
+    if (pc - ITCM_BASE < ITCM_SIZE) {
+        bin = &bins.itcm[(pc - ITCM_BASE) >> ITCM_SHIFT];
+    } else if (pc - FLASH_BASE < FLASH_SPAN) {
+        bin = &bins.flash[(pc - FLASH_BASE) >> FLASH_SHIFT];
+    }
+    if (bin) {
+        ++*bin;
+    } else {
+        ++bins.outside;
+    }
+    ++bins.total;
+    asm volatile("dsb");  // flag clear must land before the exception returns
+}
+
+/// Reads the stacked PC (offset 24 of the exception frame) and records it
+extern "C" __attribute__((naked)) void minimalPcSampleIsr() {
+    asm volatile(
+        "tst lr, #4\n"
+        "ite eq\n"
+        "mrseq r0, msp\n"
+        "mrsne r0, psp\n"
+        "ldr r0, [r0, #24]\n"
+        "b minimalPcSampleRecord\n");
+}
+
+namespace minimal::profile {
+
+FLASHMEM void begin() {
+    memset(&bins, 0, sizeof(bins));
+    CCM_CCGR1 |= CCM_CCGR1_GPT1_BUS(CCM_CCGR_ON) | CCM_CCGR1_GPT1_SERIAL(CCM_CCGR_ON);
+    GPT1_CR = 0;
+    GPT1_PR = 0;
+    GPT1_SR = 0x3F;
+    GPT1_IR = GPT_IR_OF1IE;
+    GPT1_OCR1 = perclkHz() / SAMPLE_HZ - 1;
+    attachInterruptVector(IRQ_GPT1, minimalPcSampleIsr);
+    NVIC_SET_PRIORITY(IRQ_GPT1, 0);  // preempt everything we want to see
+    NVIC_ENABLE_IRQ(IRQ_GPT1);
+    GPT1_CR = GPT_CR_EN | GPT_CR_CLKSRC(1);  // restart mode, PERCLK
+}
+
+FLASHMEM void dump() {
+    NVIC_DISABLE_IRQ(IRQ_GPT1);
+    for (uint32_t i = 0; i < (ITCM_SIZE >> ITCM_SHIFT); ++i) {
+        if (bins.itcm[i]) {
+            Serial.printf("PGO %08lx %lu\n", ITCM_BASE + (i << ITCM_SHIFT), bins.itcm[i]);
+        }
+    }
+    for (uint32_t i = 0; i < (FLASH_SPAN >> FLASH_SHIFT); ++i) {
+        if (bins.flash[i]) {
+            Serial.printf("PGO %08lx %lu\n", FLASH_BASE + (i << FLASH_SHIFT), bins.flash[i]);
+        }
+    }
+    Serial.printf("PGO END %lu outside=%lu\n", bins.total, bins.outside);
+    memset(&bins, 0, sizeof(bins));  // each dump covers one window; the script sums them
+    NVIC_ENABLE_IRQ(IRQ_GPT1);
+}
+
+}  // namespace minimal::profile
+
+#endif
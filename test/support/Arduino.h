@@ -0,0 +1,71 @@
+#pragma once
+
+/**
+ * @file Arduino.h
+ * @brief Host stand-in for the Teensy core, native tests only
+ *
+ * Just what the headers under test touch: the clock and the USB-MIDI TX
+ * path. Packets are recorded in order in usbHost, which also plays the
+ * host side: setTxBusy() leaves TX data untaken (the MIDI endpoint stays
+ * primed), stallUs makes the next write block like a stalled host.
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#define FASTRUN
+#define FLASHMEM
+
+inline uint32_t micros() {
+    using namespace std::chrono;
+    return static_cast<uint32_t>(
+        duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count());
+}
+inline uint32_t millis() { return micros() / 1000; }
+
+// ── USB device controller: MIDI TX endpoint status ──
+
+#define MIDI_TX_ENDPOINT 3
+inline volatile uint32_t hostEndptStat = 0;
+#define USB1_ENDPTSTAT hostEndptStat
+
+struct UsbHost {
+    std::vector<uint32_t> packets;  ///< every usb_midi_write_packed(), in order
+    uint32_t flushes = 0;           ///< send_now() calls
+    size_t sysexAt = SIZE_MAX;      ///< packets written before the last SysEx
+    uint32_t stallUs = 0;           ///< next write blocks this long (0: no stall)
+
+    void setTxBusy(bool busy) {
+        hostEndptStat = busy ? (1u << (16 + MIDI_TX_ENDPOINT)) : 0;
+    }
+    void reset() {
+        packets.clear();
+        flushes = 0;
+        sysexAt = SIZE_MAX;
+        stallUs = 0;
+        setTxBusy(false);
+    }
+};
+
+inline UsbHost usbHost;
+
+extern "C" inline void usb_midi_write_packed(uint32_t word) {
+    if (usbHost.stallUs) {
+        std::this_thread::sleep_for(std::chrono::microseconds(usbHost.stallUs));
+        usbHost.stallUs = 0;
+        return;  // the core drops the packet after its timeout
+    }
+    usbHost.packets.push_back(word);
+}
+
+struct UsbMidiHost {
+    void send_now() { ++usbHost.flushes; }
+    void sendSysEx(uint32_t, const uint8_t*, bool = false, uint8_t = 0) {
+        usbHost.sysexAt = usbHost.packets.size();
+    }
+};
+
+inline UsbMidiHost usbMIDI;
@@ -0,0 +1,164 @@
+/**
+ * @file test_main.cpp
+ * @brief IncomingDispatcher: routing, and throughput at 10k msgs/s on the host
+ *
+ * pio test -e native -f test_dispatcher -v   (prints the benchmark lines)
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+
+#include <unity.h>
+
+#include "midi/IncomingDispatcher.hpp"
+
+using minimal::midi::Handler;
+using minimal::midi::IncomingDispatcher;
+using minimal::midi::MessageType;
+
+namespace {
+
+struct Hits {
+    uint32_t count = 0;
+    uint32_t sum = 0;
+    uint8_t lastChannel = 0xFF;
+    uint8_t lastData1 = 0;
+    uint8_t lastData2 = 0;
+};
+
+void onMessage(void* ctx, uint8_t channel, uint8_t data1, uint8_t data2) {
+    auto* hits = static_cast<Hits*>(ctx);
+    ++hits->count;
+    hits->sum += data2;
+    hits->lastChannel = channel;
+    hits->lastData1 = data1;
+    hits->lastData2 = data2;
+}
+
+/// Deterministic inputs (same numbers on every run)
+struct Lcg {
+    uint32_t state = 12345;
+    uint32_t next() { return state = state * 1664525u + 1013904223u; }
+};
+
+struct Message {
+    uint8_t status;
+    uint8_t data1;
+    uint8_t data2;
+};
+
+}  // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_routes_each_binding_to_its_handler() {
+    IncomingDispatcher<64> in;
+    Hits hits[64];
+    for (uint8_t i = 0; i < 64; ++i) {
+        TEST_ASSERT_TRUE(in.subscribe(MessageType::ControlChange, i % 16, i, {&onMessage, &hits[i]}));
+    }
+    TEST_ASSERT_TRUE(in.rebuild());
+
+    for (uint8_t i = 0; i < 64; ++i) {
+        TEST_ASSERT_TRUE(in.dispatch(static_cast<uint8_t>(0xB0 | (i % 16)), i, 100));
+        TEST_ASSERT_EQUAL_UINT32(1, hits[i].count);
+        TEST_ASSERT_EQUAL_UINT8(i % 16, hits[i].lastChannel);
+        TEST_ASSERT_EQUAL_UINT8(i, hits[i].lastData1);
+    }
+}
+
+void test_drops_unsubscribed_messages() {
+    IncomingDispatcher<8> in;
+    Hits hits;
+    in.subscribe(MessageType::ControlChange, 0, 16, {&onMessage, &hits});
+    in.subscribe(MessageType::PitchBend, 2, 0, {&onMessage, &hits});
+    in.rebuild();
+
+    TEST_ASSERT_FALSE(in.dispatch(0xB0, 17, 1));  // other CC
+    TEST_ASSERT_FALSE(in.dispatch(0xB1, 16, 1));  // other channel
+    TEST_ASSERT_FALSE(in.dispatch(0x90, 16, 1));  // other type
+    TEST_ASSERT_FALSE(in.dispatch(0xF8, 0, 0));   // not a channel message
+    TEST_ASSERT_EQUAL_UINT32(0, hits.count);
+
+    TEST_ASSERT_TRUE(in.dispatch(0xE2, 0x11, 0x40));  // pitch bend: any data1
+    TEST_ASSERT_EQUAL_UINT32(1, hits.count);
+}
+
+void test_resubscribe_replaces_handler() {
+    IncomingDispatcher<4> in;
+    Hits first;
+    Hits second;
+    in.subscribe(MessageType::NoteOn, 0, 60, {&onMessage, &first});
+    in.subscribe(MessageType::NoteOn, 0, 60, {&onMessage, &second});
+    in.rebuild();
+    TEST_ASSERT_EQUAL(1, in.size());
+    in.dispatch(0x90, 60, 100);
+    TEST_ASSERT_EQUAL_UINT32(0, first.count);
+    TEST_ASSERT_EQUAL_UINT32(1, second.count);
+}
+
+/**
+ * One second of traffic at 10k msgs/s: 64 bound CCs, the rest DAW feedback
+ * nobody subscribed to (meters, other channels). Dispatch must take a
+ * negligible share of that second.
+ */
+void test_throughput_10k_messages_per_second() {
+    constexpr uint32_t MESSAGES = 10000;
+    constexpr uint32_t ROUNDS = 100;
+
+    IncomingDispatcher<64> in;
+    Hits hits;
+    for (uint8_t i = 0; i < 64; ++i) {
+        in.subscribe(MessageType::ControlChange, i / 32, static_cast<uint8_t>(16 + i % 32),
+                     {&onMessage, &hits});
+    }
+    in.rebuild();
+
+    static Message traffic[MESSAGES];
+    Lcg rng;
+    uint32_t expected = 0;
+    for (auto& m : traffic) {
+        uint32_t r = rng.next();
+        if ((r >> 24) < 64) {  // 25 %: a bound CC
+            m = {static_cast<uint8_t>(0xB0 | ((r >> 8) & 1)), static_cast<uint8_t>(16 + (r >> 12) % 32),
+                 static_cast<uint8_t>((r >> 16) & 0x7F)};
+            ++expected;
+        } else if ((r >> 24) < 160) {  // meters on channel pressure
+            m = {static_cast<uint8_t>(0xD0 | ((r >> 8) & 0x0F)), static_cast<uint8_t>((r >> 12) & 0x7F), 0};
+        } else {  // CCs and notes nobody listens to
+            uint8_t type = (r & 1) ? 0xB0 : 0x90;
+            m = {static_cast<uint8_t>(type | (2 + (r >> 8) % 14)), static_cast<uint8_t>((r >> 12) & 0x7F),
+                 static_cast<uint8_t>((r >> 20) & 0x7F)};
+        }
+    }
+
+    using Clock = std::chrono::steady_clock;
+    uint32_t routed = 0;
+    auto start = Clock::now();
+    for (uint32_t round = 0; round < ROUNDS; ++round) {
+        for (const auto& m : traffic) routed += in.dispatch(m.status, m.data1, m.data2);
+    }
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+    TEST_ASSERT_EQUAL_UINT32(expected * ROUNDS, routed);
+    TEST_ASSERT_EQUAL_UINT32(expected * ROUNDS, hits.count);
+
+    double nsPerMessage = ns / (MESSAGES * ROUNDS);
+    double busyShare = nsPerMessage * MESSAGES / 1e9;  // of each second at 10k msgs/s
+    char line[128];
+    std::snprintf(line, sizeof(line), "BENCH dispatch %.1f ns/msg, %.4f %% of a second at 10k msgs/s",
+                  nsPerMessage, busyShare * 100.0);
+    TEST_MESSAGE(line);
+    TEST_ASSERT_TRUE_MESSAGE(busyShare < 0.01, "dispatch takes over 1 % of the time at 10k msgs/s");
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_routes_each_binding_to_its_handler);
+    RUN_TEST(test_drops_unsubscribed_messages);
+    RUN_TEST(test_resubscribe_replaces_handler);
+    RUN_TEST(test_throughput_10k_messages_per_second);
+    return UNITY_END();
+}
@@ -0,0 +1,236 @@
+/**
+ * @file test_main.cpp
+ * @brief Batch kernels against a double-precision reference, each within
+ *        the error its doc comment states
+ *
+ * Runs the portable primitives, which are bit-identical to the M7
+ * instructions (dsp/Simd.hpp).
+ *
+ * pio test -e native -f test_dsp -v   (prints the measured errors)
+ */
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+
+#include <unity.h>
+
+#include "dsp/Kernels.hpp"
+
+namespace dsp = minimal::dsp;
+
+namespace {
+
+constexpr size_t N = 4096;
+
+struct Rng {
+    uint32_t state = 12345;
+    uint32_t next() { return state = state * 1664525u + 1013904223u; }
+    int16_t q15() { return static_cast<int16_t>(next() >> 16); }
+    int16_t unipolar() { return static_cast<int16_t>(next() >> 17); }
+    int32_t q31() { return static_cast<int32_t>(next() ^ (next() << 16)); }
+};
+
+/// Random values with the extremes at the start, where saturation happens
+void fill(int16_t* v, Rng& rng) {
+    const int16_t edges[] = {INT16_MIN, INT16_MAX, 0, -1, 1, INT16_MIN + 1};
+    for (size_t i = 0; i < N; ++i) v[i] = i < 6 ? edges[i] : rng.q15();
+}
+
+void fill(int32_t* v, Rng& rng) {
+    const int32_t edges[] = {INT32_MIN, INT32_MAX, 0, -1, 1, INT32_MIN + 1};
+    for (size_t i = 0; i < N; ++i) v[i] = i < 6 ? edges[i] : rng.q31();
+}
+
+double clamp(double v, double lo, double hi) { return v < lo ? lo : v > hi ? hi : v; }
+
+/// Largest |out - reference| seen by one kernel, in LSBs
+struct MaxError {
+    const char* name;
+    double max = 0;
+
+    void add(double out, double reference) {
+        double e = std::fabs(out - reference);
+        if (e > max) max = e;
+    }
+    void print(double bound) const {
+        char line[96];
+        std::snprintf(line, sizeof(line), "%s: max error %.3f LSB (bound %.1f)", name, max, bound);
+        TEST_MESSAGE(line);
+    }
+};
+
+int16_t a15[N], b15[N], out15[N];
+int32_t a31[N], b31[N], out31[N];
+
+}  // namespace
+
+void setUp() {
+    Rng rng;
+    fill(a15, rng);
+    fill(b15, rng);
+    fill(a31, rng);
+    fill(b31, rng);
+}
+
+void tearDown() {}
+
+// ── Q15 ──
+
+void test_q15_add_saturates_exactly() {
+    dsp::add(a15, b15, out15, N - 1);  // odd count: covers the scalar tail
+    for (size_t i = 0; i < N - 1; ++i) {
+        TEST_ASSERT_EQUAL(clamp(a15[i] + b15[i], INT16_MIN, INT16_MAX), out15[i]);
+    }
+}
+
+void test_q15_scale_within_1_lsb_low() {
+    const int16_t gains[] = {INT16_MIN, -16384, 0, 1, 12345, INT16_MAX};
+    MaxError err{"q15 scale"};
+    for (int16_t gain : gains) {
+        dsp::scale(a15, gain, out15, N);
+        for (size_t i = 0; i < N; ++i) {
+            double reference = clamp(a15[i] * static_cast<double>(gain) / 32768.0, INT16_MIN,
+                                     INT16_MAX);
+            TEST_ASSERT_TRUE(out15[i] <= reference);
+            err.add(out15[i], reference);
+        }
+    }
+    err.print(1);
+    TEST_ASSERT_TRUE(err.max < 1.0);
+}
+
+void test_q15_mix_within_half_lsb() {
+    const int16_t positions[] = {0, 1, 8192, 16384, 32766, INT16_MAX};
+    MaxError err{"q15 mix"};
+    for (int16_t t : positions) {
+        dsp::mix(a15, b15, t, out15, N - 1);
+        for (size_t i = 0; i < N - 1; ++i) {
+            err.add(out15[i], a15[i] + (b15[i] - a15[i]) * (t / 32768.0));
+        }
+    }
+    err.print(0.5);
+    TEST_ASSERT_TRUE(err.max <= 0.5);
+
+    // Negative positions clamp to a
+    dsp::mix(a15, b15, -1, out15, N);
+    TEST_ASSERT_EQUAL_MEMORY(a15, out15, sizeof(a15));
+}
+
+void test_q15_curve_within_half_lsb_of_segment() {
+    int16_t table[dsp::CURVE_POINTS];
+    for (size_t p = 0; p < dsp::CURVE_POINTS; ++p) {
+        // Log-like response, steep at the bottom
+        table[p] = static_cast<int16_t>(32767.0 * std::sqrt(p / 32.0));
+    }
+    Rng rng;
+    for (size_t i = 0; i < N; ++i) a15[i] = i < 3 ? (i == 0 ? INT16_MAX : 0) : rng.unipolar();
+    a15[3] = -100;
+
+    dsp::curve(a15, table, out15, N - 1);
+    MaxError err{"q15 curve"};
+    for (size_t i = 0; i < N - 1; ++i) {
+        int v = a15[i] < 0 ? 0 : a15[i];
+        int segment = v >> 10;
+        double frac = (v & 0x3FF) / 1024.0;
+        err.add(out15[i], table[segment] + (table[segment + 1] - table[segment]) * frac);
+    }
+    err.print(0.5);
+    TEST_ASSERT_TRUE(err.max <= 0.5);
+    TEST_ASSERT_EQUAL(table[0], out15[3]);
+}
+
+void test_q15_to_midi_matches_float_rounding() {
+    uint8_t cc[N];
+    uint16_t cc14[N];
+    dsp::toMidi7(a15, cc, N - 1);
+    dsp::toMidi14(a15, cc14, N - 1);
+    for (size_t i = 0; i < N - 1; ++i) {
+        float v = a15[i] < 0 ? 0.0f : dsp::fromQ15(a15[i]);
+        TEST_ASSERT_EQUAL(static_cast<int>(v * 127.0f + 0.5f), cc[i]);
+        TEST_ASSERT_EQUAL(static_cast<int>(std::floor(v * 16383.0 + 0.5)), cc14[i]);
+    }
+}
+
+void test_q15_float_round_trip() {
+    float values[N];
+    dsp::fromQ15(a15, values, N);
+    dsp::toQ15(values, out15, N);
+    TEST_ASSERT_EQUAL_MEMORY(a15, out15, sizeof(a15));
+
+    const float inputs[] = {-2.0f, -1.0f, -0.5f, 0.0f, 0.25f, 0.99999f, 1.0f, 2.0f};
+    int16_t q[8];
+    dsp::toQ15(inputs, q, 8);
+    for (size_t i = 0; i < 8; ++i) {
+        double reference = clamp(inputs[i] * 32768.0, INT16_MIN, INT16_MAX);
+        TEST_ASSERT_TRUE(std::fabs(q[i] - reference) <= 0.5);
+    }
+}
+
+// ── Q31 ──
+
+void test_q31_add_saturates_exactly() {
+    dsp::add(a31, b31, out31, N);
+    for (size_t i = 0; i < N; ++i) {
+        int64_t sum = static_cast<int64_t>(a31[i]) + b31[i];
+        TEST_ASSERT_EQUAL(clamp(static_cast<double>(sum), INT32_MIN, INT32_MAX), out31[i]);
+    }
+}
+
+void test_q31_scale_within_2_lsb_low() {
+    const int32_t gains[] = {INT32_MIN, -(1 << 30), 0, 1, 1234567891, INT32_MAX};
+    MaxError err{"q31 scale"};
+    for (int32_t gain : gains) {
+        dsp::scale(a31, gain, out31, N);
+        for (size_t i = 0; i < N; ++i) {
+            long double reference = static_cast<long double>(a31[i]) * gain / 2147483648.0L;
+            if (reference > INT32_MAX) reference = INT32_MAX;
+            TEST_ASSERT_TRUE(out31[i] <= reference);
+            err.add(static_cast<double>(out31[i] - reference), 0);
+        }
+    }
+    err.print(2);
+    TEST_ASSERT_TRUE(err.max < 2.0);
+}
+
+void test_q31_mix_within_3_lsb() {
+    const int32_t positions[] = {0, 1, 1 << 29, 1 << 30, INT32_MAX - 1, INT32_MAX};
+    MaxError err{"q31 mix"};
+    for (int32_t t : positions) {
+        dsp::mix(a31, b31, t, out31, N);
+        for (size_t i = 0; i < N; ++i) {
+            long double delta = static_cast<long double>(b31[i]) - a31[i];
+            long double reference = a31[i] + delta * t / 2147483648.0L;
+            if (reference > INT32_MAX) reference = INT32_MAX;
+            err.add(static_cast<double>(out31[i] - reference), 0);
+        }
+    }
+    // Sweep t on the values where halving loses the most (odd a and b)
+    for (int k = 0; k < 4096; ++k) {
+        int32_t t = static_cast<int32_t>(static_cast<uint32_t>(k) * 524287u);
+        for (size_t i = 0; i < 64; ++i) {
+            int32_t a = a31[i] | 1, b = b31[i] | 1;
+            int32_t out;
+            dsp::mix(&a, &b, t, &out, 1);
+            long double reference = a + (static_cast<long double>(b) - a) * t / 2147483648.0L;
+            if (reference > INT32_MAX) reference = INT32_MAX;
+            err.add(static_cast<double>(out - reference), 0);
+        }
+    }
+    err.print(3);
+    TEST_ASSERT_TRUE(err.max <= 3.0);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_q15_add_saturates_exactly);
+    RUN_TEST(test_q15_scale_within_1_lsb_low);
+    RUN_TEST(test_q15_mix_within_half_lsb);
+    RUN_TEST(test_q15_curve_within_half_lsb_of_segment);
+    RUN_TEST(test_q15_to_midi_matches_float_rounding);
+    RUN_TEST(test_q15_float_round_trip);
+    RUN_TEST(test_q31_add_saturates_exactly);
+    RUN_TEST(test_q31_scale_within_2_lsb_low);
+    RUN_TEST(test_q31_mix_within_3_lsb);
+    return UNITY_END();
+}
@@ -0,0 +1,257 @@
+/**
+ * @file test_main.cpp
+ * @brief ReportBatcher: one report per frame, chords merged, double
+ *        toggles split, and no stuck keys when the queue is full
+ *
+ * pio test -e native -f test_hid
+ */
+
+#include <cstdint>
+#include <cstring>
+
+#include <unity.h>
+
+#include "hid/ReportBatcher.hpp"
+
+using minimal::hid::Chord;
+using minimal::hid::ReportBatcher;
+namespace key = minimal::hid::key;
+namespace mod = minimal::hid::mod;
+namespace consumer = minimal::hid::consumer;
+
+namespace {
+
+struct Report {
+    uint8_t modifiers;
+    uint8_t keys[6];
+
+    bool has(uint8_t usage) const {
+        for (uint8_t k : keys) {
+            if (k == usage) return true;
+        }
+        return false;
+    }
+    bool empty() const { return modifiers == 0 && keys[0] == 0; }
+};
+
+/// Records what reaches the host; busy makes the next sends fail (endpoint not ready)
+struct FakePort {
+    Report reports[64] = {};
+    uint8_t count = 0;
+    uint16_t consumerUsage[16] = {};
+    bool consumerPressed[16] = {};
+    uint8_t consumerCount = 0;
+    bool busy = false;
+
+    bool sendKeyboard(uint8_t modifiers, const uint8_t keys[6]) {
+        if (busy) return false;
+        reports[count].modifiers = modifiers;
+        std::memcpy(reports[count].keys, keys, 6);
+        ++count;
+        return true;
+    }
+    bool sendConsumer(uint16_t usage, bool pressed) {
+        if (busy) return false;
+        consumerUsage[consumerCount] = usage;
+        consumerPressed[consumerCount] = pressed;
+        ++consumerCount;
+        return true;
+    }
+
+    const Report& last() const { return reports[count - 1]; }
+};
+
+/// Poll one frame after another until nothing is pending; @return frames used
+template <uint8_t Depth>
+uint32_t drain(ReportBatcher<Depth>& batcher, FakePort& port, uint32_t& frame) {
+    uint32_t frames = 0;
+    while (batcher.poll(++frame, port)) ++frames;
+    return frames + 1;
+}
+
+}  // namespace
+
+void setUp() {}
+void tearDown() {}
+
+/// Ctrl+S pressed from one callback: one report with modifier and key together
+void test_chord_is_one_report() {
+    ReportBatcher<> batcher;
+    FakePort port;
+    uint32_t frame = 0;
+
+    batcher.press({mod::CTRL, key::letter('s')});
+    batcher.poll(++frame, port);
+    TEST_ASSERT_EQUAL_UINT8(1, port.count);
+    TEST_ASSERT_EQUAL_HEX8(mod::CTRL, port.last().modifiers);
+    TEST_ASSERT_TRUE(port.last().has(key::letter('s')));
+
+    // Two chords pressed before the next frame merge as well
+    batcher.press({mod::SHIFT, key::letter('a')});
+    batcher.press({0, key::letter('b')});
+    batcher.poll(++frame, port);
+    TEST_ASSERT_EQUAL_UINT8(2, port.count);
+    TEST_ASSERT_EQUAL_HEX8(mod::CTRL | mod::SHIFT, port.last().modifiers);
+    TEST_ASSERT_TRUE(port.last().has(key::letter('s')));
+    TEST_ASSERT_TRUE(port.last().has(key::letter('a')));
+    TEST_ASSERT_TRUE(port.last().has(key::letter('b')));
+    TEST_ASSERT_FALSE(batcher.pending());
+}
+
+/// At most one keyboard report per frame, however often poll() runs
+void test_one_report_per_frame() {
+    ReportBatcher<> batcher;
+    FakePort port;
+    batcher.tap({0, key::ENTER});
+    batcher.poll(7, port);
+    batcher.poll(7, port);
+    batcher.poll(7, port);
+    TEST_ASSERT_EQUAL_UINT8(1, port.count);
+    batcher.poll(8, port);
+    TEST_ASSERT_EQUAL_UINT8(2, port.count);
+}
+
+/// A key pressed and released between two polls still reaches the host as a stroke
+void test_double_toggle_splits() {
+    ReportBatcher<> batcher;
+    FakePort port;
+    uint32_t frame = 0;
+
+    batcher.tap({mod::GUI, key::letter('z')});
+    TEST_ASSERT_EQUAL_UINT32(2, drain(batcher, port, frame));
+    TEST_ASSERT_EQUAL_UINT8(2, port.count);
+    TEST_ASSERT_EQUAL_HEX8(mod::GUI, port.reports[0].modifiers);
+    TEST_ASSERT_TRUE(port.reports[0].has(key::letter('z')));
+    TEST_ASSERT_TRUE(port.reports[1].empty());
+
+    // Press, release, press again within one frame: on, off, on
+    Chord space{0, key::SPACE};
+    batcher.press(space);
+    batcher.release(space);
+    batcher.press(space);
+    drain(batcher, port, frame);
+    TEST_ASSERT_EQUAL_UINT8(5, port.count);
+    TEST_ASSERT_TRUE(port.reports[2].has(key::SPACE));
+    TEST_ASSERT_TRUE(port.reports[3].empty());
+    TEST_ASSERT_TRUE(port.reports[4].has(key::SPACE));
+    TEST_ASSERT_EQUAL_UINT32(0, batcher.merged());
+}
+
+/// Every modifier bit changing twice splits too, not only keys
+void test_modifier_toggle_splits() {
+    ReportBatcher<> batcher;
+    FakePort port;
+    uint32_t frame = 0;
+    batcher.tap({mod::SHIFT, key::NONE});
+    drain(batcher, port, frame);
+    TEST_ASSERT_EQUAL_UINT8(2, port.count);
+    TEST_ASSERT_EQUAL_HEX8(mod::SHIFT, port.reports[0].modifiers);
+    TEST_ASSERT_EQUAL_HEX8(0, port.reports[1].modifiers);
+}
+
+/**
+ * More strokes than the queue holds, none polled: the overflow merges into
+ * the newest report. Strokes may be lost, the final state may not.
+ */
+void test_full_queue_merges_without_stuck_keys() {
+    ReportBatcher<2> batcher;
+    FakePort port;
+    uint32_t frame = 0;
+
+    Chord shift{mod::SHIFT, key::NONE};
+    batcher.press(shift);  // held through the burst
+    for (char c = 'a'; c <= 'j'; ++c) TEST_ASSERT_TRUE(batcher.tap({0, key::letter(c)}));
+    TEST_ASSERT_TRUE(batcher.merged() > 0);
+
+    drain(batcher, port, frame);
+    TEST_ASSERT_TRUE(port.count <= 2);
+    // Shift still held, every letter up
+    TEST_ASSERT_EQUAL_HEX8(mod::SHIFT, port.last().modifiers);
+    TEST_ASSERT_EQUAL_HEX8(0, port.last().keys[0]);
+
+    batcher.release(shift);
+    drain(batcher, port, frame);
+    TEST_ASSERT_TRUE(port.last().empty());
+    TEST_ASSERT_FALSE(batcher.pending());
+}
+
+/// Presses held across a full queue: the last report holds exactly what is down
+void test_full_queue_keeps_held_keys() {
+    ReportBatcher<2> batcher;
+    FakePort port;
+    uint32_t frame = 0;
+
+    Chord a{0, key::letter('a')};
+    Chord b{0, key::letter('b')};
+    batcher.press(a);
+    batcher.release(a);
+    batcher.press(a);
+    batcher.press(b);
+    batcher.release(a);
+    drain(batcher, port, frame);
+    TEST_ASSERT_TRUE(port.last().has(key::letter('b')));
+    TEST_ASSERT_FALSE(port.last().has(key::letter('a')));
+
+    batcher.release(b);
+    drain(batcher, port, frame);
+    TEST_ASSERT_TRUE(port.last().empty());
+}
+
+/// Endpoint busy: the report stays queued and goes out in a later frame
+void test_busy_port_retries() {
+    ReportBatcher<> batcher;
+    FakePort port;
+    batcher.tap({mod::CTRL, key::letter('c')});
+    port.busy = true;
+    TEST_ASSERT_TRUE(batcher.poll(1, port));
+    TEST_ASSERT_TRUE(batcher.poll(2, port));
+    TEST_ASSERT_EQUAL_UINT8(0, port.count);
+    port.busy = false;
+    uint32_t frame = 2;
+    drain(batcher, port, frame);
+    TEST_ASSERT_EQUAL_UINT8(2, port.count);
+    TEST_ASSERT_TRUE(port.reports[0].has(key::letter('c')));
+    TEST_ASSERT_TRUE(port.reports[1].empty());
+    TEST_ASSERT_EQUAL_UINT32(2, batcher.reports());
+}
+
+/// Boot reports carry 6 keys: a 7th held chord is refused, not silently lost
+void test_held_chords_limited() {
+    ReportBatcher<> batcher;
+    for (char c = 'a'; c < 'a' + ReportBatcher<>::MAX_HELD; ++c) {
+        TEST_ASSERT_TRUE(batcher.press({0, key::letter(c)}));
+    }
+    TEST_ASSERT_FALSE(batcher.press({0, key::letter('z')}));
+}
+
+/// Media keys: press then release, one event per frame, refused when full
+void test_consumer_events() {
+    ReportBatcher<4> batcher;
+    FakePort port;
+    TEST_ASSERT_TRUE(batcher.consumer(consumer::PLAY_PAUSE));
+    TEST_ASSERT_TRUE(batcher.consumer(consumer::STOP));
+    TEST_ASSERT_FALSE(batcher.consumer(consumer::MUTE));
+
+    uint32_t frame = 0;
+    TEST_ASSERT_EQUAL_UINT32(4, drain(batcher, port, frame));
+    TEST_ASSERT_EQUAL_UINT8(4, port.consumerCount);
+    TEST_ASSERT_EQUAL_HEX16(consumer::PLAY_PAUSE, port.consumerUsage[0]);
+    TEST_ASSERT_TRUE(port.consumerPressed[0]);
+    TEST_ASSERT_FALSE(port.consumerPressed[1]);
+    TEST_ASSERT_EQUAL_HEX16(consumer::STOP, port.consumerUsage[2]);
+    TEST_ASSERT_FALSE(port.consumerPressed[3]);
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_chord_is_one_report);
+    RUN_TEST(test_one_report_per_frame);
+    RUN_TEST(test_double_toggle_splits);
+    RUN_TEST(test_modifier_toggle_splits);
+    RUN_TEST(test_full_queue_merges_without_stuck_keys);
+    RUN_TEST(test_full_queue_keeps_held_keys);
+    RUN_TEST(test_busy_port_retries);
+    RUN_TEST(test_held_chords_limited);
+    RUN_TEST(test_consumer_events);
+    return UNITY_END();
+}
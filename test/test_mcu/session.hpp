@@ -0,0 +1,68 @@
+#pragma once
+
+/**
+ * @file session.hpp
+ * @brief Host → surface MIDI of a short DAW session, as raw bytes
+ *
+ * A transcript of what an MCU host sends to a surface on 8 strips: the
+ * connect burst (both LCD rows, every V-Pot ring, transport LEDs), play
+ * with two rounds of meters and a clip, a track rename from an extender
+ * header, a pan change, messages that are not MCU feedback, and stop.
+ * Written out from the MCU protocol (mcu/Protocol.hpp) in the order and
+ * form a DAW sends it; it is not a USB capture.
+ *
+ * Channel messages use full status bytes (USB-MIDI carries no running
+ * status). SysEx is framed with F0 / F7.
+ */
+
+#include <cstdint>
+
+namespace session {
+
+constexpr uint8_t TRAFFIC[] = {
+    // Host connects: both LCD rows, one write each
+    0xF0, 0x00, 0x00, 0x66, 0x14, 0x12, 0x00,  // LCD @0
+        'K', 'i', 'c', 'k', ' ', ' ', ' ', 'S', 'n', 'a', 'r', 'e', ' ', ' ',
+        'H', 'i', 'H', 'a', 't', ' ', ' ', 'B', 'a', 's', 's', ' ', ' ', ' ',
+        'K', 'e', 'y', 's', ' ', ' ', ' ', 'P', 'a', 'd', ' ', ' ', ' ', ' ',
+        'V', 'o', 'x', ' ', ' ', ' ', ' ', 'M', 'a', 's', 't', 'e', 'r', ' ',
+    0xF7,
+    0xF0, 0x00, 0x00, 0x66, 0x14, 0x12, 0x38,  // LCD @56
+        ' ', ' ', 'C', ' ', ' ', ' ', ' ', ' ', ' ', 'L', '2', '0', ' ', ' ',
+        ' ', 'R', '3', '5', ' ', ' ', ' ', ' ', ' ', 'C', ' ', ' ', ' ', ' ',
+        ' ', ' ', 'C', ' ', ' ', ' ', ' ', ' ', 'L', '1', '0', ' ', ' ', ' ',
+        ' ', ' ', 'C', ' ', ' ', ' ', ' ', ' ', ' ', 'C', ' ', ' ', ' ', ' ',
+    0xF7,
+    // Ring of every strip: pan on 1-7 (boost/cut, center LED), a send on 8 (wrap)
+    0xB0, 0x30, 0x56, 0xB0, 0x31, 0x54, 0xB0, 0x32, 0x59, 0xB0, 0x33, 0x56,
+    0xB0, 0x34, 0x56, 0xB0, 0x35, 0x55, 0xB0, 0x36, 0x56, 0xB0, 0x37, 0x26,
+    // Transport LEDs: stop on; select of strip 1
+    0x90, 0x5D, 0x7F, 0x90, 0x18, 0x7F,
+    // Play pressed on the surface: play on, stop off, record arm of strip 3 blinking
+    0x90, 0x5E, 0x7F, 0x90, 0x5D, 0x00, 0x90, 0x02, 0x01,
+    // Meters while playing (one round per strip), strip 8 clips
+    0xD0, 0x09, 0xD0, 0x17, 0xD0, 0x25, 0xD0, 0x38, 0xD0, 0x46, 0xD0, 0x54, 0xD0, 0x67, 0xD0, 0x7C,
+    0xD0, 0x7E,
+    0xD0, 0x08, 0xD0, 0x16, 0xD0, 0x24, 0xD0, 0x39, 0xD0, 0x45, 0xD0, 0x53, 0xD0, 0x66, 0xD0, 0x7B,
+    // Rename of strip 2 (partial LCD write), from an extender header (model 15)
+    0xF0, 0x00, 0x00, 0x66, 0x15, 0x12, 0x07,  // LCD @7
+        'S', 'n', 'r', ' ', '2', ' ', ' ',
+    0xF7,
+    // Pan of strip 2 moved in the DAW
+    0xB0, 0x31, 0x52,
+    // Not MCU feedback: device query SysEx, CC on channel 2, fader touch note on channel 2
+    0xF0, 0x00, 0x00, 0x66, 0x14, 0x00, 0xF7,
+    0xB1, 0x30, 0x05, 0x91, 0x68, 0x7F,
+    // Stop: play off, stop on, record arm off (note off), clip cleared
+    0x90, 0x5E, 0x00, 0x90, 0x5D, 0x7F, 0x80, 0x02, 0x40, 0xD0, 0x7F,
+};
+
+/// LCD rows after the session
+constexpr char TOP_ROW[] = "Kick   Snr 2  HiHat  Bass   Keys   Pad    Vox    Master ";
+constexpr char BOTTOM_ROW[] = "  C      L20   R35     C      C     L10     C      C    ";
+
+/// Messages in TRAFFIC that are MCU feedback, and those that are not
+constexpr uint32_t FEEDBACK_MESSAGES = 38;
+constexpr uint32_t OTHER_MESSAGES = 3;
+
+}  // namespace session
@@ -0,0 +1,213 @@
+/**
+ * @file test_main.cpp
+ * @brief MCU feedback: replay of a DAW session (session.hpp), a meter
+ *        flood at far above DAW rates, and the V-Pot encoding sent back
+ *
+ * pio test -e native -f test_mcu -v   (prints the benchmark line)
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include <unity.h>
+
+#include "mcu/Feedback.hpp"
+#include "mcu/Protocol.hpp"
+#include "mcu/VPot.hpp"
+#include "session.hpp"
+
+using minimal::mcu::Feedback;
+using minimal::mcu::RingMode;
+namespace note = minimal::mcu::note;
+
+namespace {
+
+struct Replay {
+    uint32_t accepted = 0;
+    uint32_t rejected = 0;
+};
+
+/// Split a raw byte stream into channel messages and SysEx, as UsbMidiInput delivers them
+Replay replay(Feedback& feedback, const uint8_t* bytes, size_t length) {
+    Replay r;
+    size_t i = 0;
+    while (i < length) {
+        uint8_t status = bytes[i];
+        bool ok;
+        if (status == 0xF0) {
+            size_t end = i;
+            while (end < length && bytes[end] != 0xF7) ++end;
+            ok = feedback.onSysEx(bytes + i, end - i + 1);
+            i = end + 1;
+        } else {
+            bool oneDataByte = (status & 0xF0) == 0xC0 || (status & 0xF0) == 0xD0;
+            uint8_t data2 = oneDataByte ? 0 : bytes[i + 2];
+            ok = feedback.onChannelMessage(status, bytes[i + 1], data2);
+            i += oneDataByte ? 2 : 3;
+        }
+        ++(ok ? r.accepted : r.rejected);
+    }
+    return r;
+}
+
+}  // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_session_replay_state() {
+    Feedback fb;
+    Replay r = replay(fb, session::TRAFFIC, sizeof(session::TRAFFIC));
+    TEST_ASSERT_EQUAL_UINT32(session::FEEDBACK_MESSAGES, r.accepted);
+    TEST_ASSERT_EQUAL_UINT32(session::OTHER_MESSAGES, r.rejected);
+
+    TEST_ASSERT_EQUAL_STRING(session::TOP_ROW, fb.lcd(0));
+    TEST_ASSERT_EQUAL_STRING(session::BOTTOM_ROW, fb.lcd(1));
+
+    // Strip 1: pan centered; strip 2: moved left in the DAW; strip 8: send level
+    TEST_ASSERT_EQUAL_UINT8(6, fb.ringPosition(0));
+    TEST_ASSERT_TRUE(fb.ringMode(0) == RingMode::BoostCut);
+    TEST_ASSERT_TRUE(fb.ringCenter(0));
+    TEST_ASSERT_EQUAL_HEX16(0x0020, fb.ringLeds(0));
+    TEST_ASSERT_EQUAL_UINT8(2, fb.ringPosition(1));
+    TEST_ASSERT_EQUAL_HEX16(0x003E, fb.ringLeds(1));  // LEDs 2-6: boost/cut fills to the center
+    TEST_ASSERT_TRUE(fb.ringMode(7) == RingMode::Wrap);
+    TEST_ASSERT_FALSE(fb.ringCenter(7));
+    TEST_ASSERT_EQUAL_HEX16(0x003F, fb.ringLeds(7));
+
+    TEST_ASSERT_FALSE(fb.led(note::PLAY));
+    TEST_ASSERT_TRUE(fb.led(note::STOP));
+    TEST_ASSERT_TRUE(fb.led(note::SELECT + 0));
+    TEST_ASSERT_FALSE(fb.led(note::REC_ARM + 2));
+    TEST_ASSERT_FALSE(fb.ledBlinking(note::REC_ARM + 2));
+
+    // Second meter round; the clip of strip 8 was cleared at stop
+    const uint8_t levels[] = {8, 6, 4, 9, 5, 3, 6, 11};
+    for (uint8_t s = 0; s < minimal::mcu::STRIPS; ++s) TEST_ASSERT_EQUAL_UINT8(levels[s], fb.meter(s));
+    TEST_ASSERT_FALSE(fb.overload(7));
+
+    uint32_t changes = fb.takeChanges();
+    TEST_ASSERT_EQUAL_HEX32(0x01FFFFFF, changes);  // every ring, meter, LCD cell and the LEDs
+    TEST_ASSERT_EQUAL_HEX32(0, fb.takeChanges());
+}
+
+/// Replaying the session again passes through its transitions and ends in the same state
+void test_session_replay_twice() {
+    Feedback fb;
+    replay(fb, session::TRAFFIC, sizeof(session::TRAFFIC));
+    fb.takeChanges();
+    replay(fb, session::TRAFFIC, sizeof(session::TRAFFIC));
+    TEST_ASSERT_EQUAL_STRING(session::TOP_ROW, fb.lcd(0));
+    TEST_ASSERT_EQUAL_UINT8(2, fb.ringPosition(1));
+    TEST_ASSERT_TRUE(fb.led(note::STOP));
+}
+
+/**
+ * Meter flood: every strip refreshed every 1 ms for 10 s (80k messages,
+ * ten times what a DAW sends while playing), with a clip on and off each
+ * second. Only meter bits may change, the state must follow the last
+ * message, and parsing must take a negligible share of each second.
+ */
+void test_meter_flood() {
+    constexpr uint32_t MS = 10000;
+    constexpr uint32_t MESSAGES = MS * minimal::mcu::STRIPS;
+
+    Feedback fb;
+    replay(fb, session::TRAFFIC, sizeof(session::TRAFFIC));
+    fb.takeChanges();
+
+    static uint8_t traffic[MESSAGES * 2 + 4 * (MS / 1000)];
+    size_t n = 0;
+    for (uint32_t ms = 0; ms < MS; ++ms) {
+        for (uint8_t s = 0; s < minimal::mcu::STRIPS; ++s) {
+            traffic[n++] = 0xD0;
+            traffic[n++] = static_cast<uint8_t>(s << 4 | ((ms + s * 3) % 13));
+        }
+        if (ms % 1000 == 500) {
+            traffic[n++] = 0xD0;
+            traffic[n++] = 0x3E;  // strip 4 clips
+        } else if (ms % 1000 == 900) {
+            traffic[n++] = 0xD0;
+            traffic[n++] = 0x3F;
+        }
+    }
+
+    using Clock = std::chrono::steady_clock;
+    uint32_t otherChanges = 0;
+    uint32_t lastDecayMs = 0;
+    auto start = Clock::now();
+    size_t i = 0;
+    for (uint32_t ms = 0; ms < MS; ++ms) {
+        // One millisecond of traffic, then what loop() does: decay, take changes
+        size_t end = i + 2 * minimal::mcu::STRIPS + (ms % 1000 == 500 || ms % 1000 == 900 ? 2 : 0);
+        replay(fb, traffic + i, end - i);
+        i = end;
+        fb.decayMeters(ms);
+        otherChanges |= fb.takeChanges() & ~0x0000FF00u;
+        lastDecayMs = ms;
+    }
+    double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+    TEST_ASSERT_EQUAL_UINT32(n, i);
+
+    TEST_ASSERT_EQUAL_HEX32(0, otherChanges);
+    for (uint8_t s = 0; s < minimal::mcu::STRIPS; ++s) {
+        // Refreshed every period: the decay never took a segment
+        TEST_ASSERT_EQUAL_UINT8(((MS - 1) + s * 3) % 13, fb.meter(s));
+    }
+    TEST_ASSERT_FALSE(fb.overload(3));
+    TEST_ASSERT_EQUAL_STRING(session::TOP_ROW, fb.lcd(0));
+    TEST_ASSERT_TRUE(fb.led(note::STOP));
+
+    // Host stops refreshing: one segment per METER_DECAY_MS
+    uint8_t before = fb.meter(3);
+    TEST_ASSERT_EQUAL_UINT8(11, before);
+    uint32_t now = lastDecayMs;
+    for (uint8_t k = 0; k < 3; ++k) {
+        now += Feedback::METER_DECAY_MS;
+        fb.decayMeters(now);
+    }
+    // The first period still counts the flood's last refresh
+    TEST_ASSERT_EQUAL_UINT8(before - 2, fb.meter(3));
+
+    double nsPerMessage = ns / static_cast<double>(n / 2);
+    double busyShare = ns / (MS * 1e6);
+    char line[128];
+    std::snprintf(line, sizeof(line), "BENCH mcu meters %.1f ns/msg, %.4f %% of the time at 8k msgs/s",
+                  nsPerMessage, busyShare * 100.0);
+    TEST_MESSAGE(line);
+    TEST_ASSERT_TRUE_MESSAGE(busyShare < 0.01, "meter parsing takes over 1 % of the time");
+}
+
+/// Surface → host: ticks within ±63, 0x40 marks counter-clockwise, never 0
+void test_vpot_encoding_round_trip() {
+    for (int ticks = -100; ticks <= 100; ++ticks) {
+        if (ticks == 0) continue;
+        uint8_t value = minimal::mcu::encodeVPot(ticks);
+        int clamped = ticks > 63 ? 63 : ticks < -63 ? -63 : ticks;
+        int decoded = (value & 0x40) ? -(value & 0x3F) : value;
+        TEST_ASSERT_EQUAL_INT(clamped, decoded);
+        TEST_ASSERT_TRUE(value != 0 && value < 0x80);
+    }
+}
+
+/// A slow detent is one tick; a fast spin is accelerated, clamped per message
+void test_vpot_acceleration() {
+    minimal::mcu::VPot vpot;
+    TEST_ASSERT_EQUAL_INT(1, vpot.ticks(1.0f, 1000));
+    TEST_ASSERT_EQUAL_INT(1, vpot.ticks(1.0f, 1000 + minimal::mcu::VPot::SLOW_MS));
+    int fast = vpot.ticks(1.0f, 1000 + minimal::mcu::VPot::SLOW_MS + 2);
+    TEST_ASSERT_EQUAL_INT(6, fast);
+    TEST_ASSERT_EQUAL_INT(-63, vpot.ticks(-100.0f, 1000 + minimal::mcu::VPot::SLOW_MS + 4));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_session_replay_state);
+    RUN_TEST(test_session_replay_twice);
+    RUN_TEST(test_meter_flood);
+    RUN_TEST(test_vpot_encoding_round_trip);
+    RUN_TEST(test_vpot_acceleration);
+    return UNITY_END();
+}
@@ -0,0 +1,149 @@
+/**
+ * @file test_main.cpp
+ * @brief OutputQueue: interrupt writes deferred while USB is busy go out
+ *        in order, and a stall ends in All Notes Off, never a stuck note
+ *
+ * Uses the host Arduino shim in test/support (packets recorded in usbHost).
+ *
+ * pio test -e native -f test_output
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#include <unity.h>
+
+#include "midi/PackedMessage.hpp"
+#include "seq/NoteRepeat.hpp"
+
+using minimal::midi::Cin;
+using minimal::midi::IsrWrite;
+using minimal::midi::OutputMode;
+using minimal::midi::packUsbMidi;
+using minimal::midi::usbOut;
+using minimal::seq::NoteRepeat;
+
+namespace {
+
+constexpr uint8_t CH = 0;
+constexpr uint8_t NOTE = 36;
+
+const uint32_t noteOn = packUsbMidi(Cin::NoteOn, CH, NOTE, 100);
+const uint32_t noteOff = packUsbMidi(Cin::NoteOff, CH, NOTE, 0);
+
+/// What NoteRepeat's timer interrupt writes for one held note
+IsrWrite retriggerFromIsr() {
+    const uint32_t words[2] = {noteOff, noteOn};
+    return usbOut.writeFromIsr(words, 2);
+}
+
+/// Whether the recorded output leaves NOTE sounding
+bool noteSounding() {
+    bool on = false;
+    for (uint32_t w : usbHost.packets) {
+        if (w == noteOn) on = true;
+        if (w == noteOff) on = false;
+        if (w == packUsbMidi(Cin::ControlChange, CH, 123, 0)) on = false;
+    }
+    return on;
+}
+
+}  // namespace
+
+void setUp() {
+    // Leave nothing deferred from the previous test
+    usbHost.reset();
+    usbOut.poll();
+    usbHost.reset();
+}
+
+void tearDown() {}
+
+void test_deferred_retrigger_goes_out_before_release() {
+    NoteRepeat repeat(CH);
+    repeat.press(NOTE);
+
+    usbHost.setTxBusy(true);
+    TEST_ASSERT_EQUAL(static_cast<int>(IsrWrite::Deferred),
+                      static_cast<int>(retriggerFromIsr()));
+    TEST_ASSERT_EQUAL(1, usbHost.packets.size());
+
+    // Pad released before loop() polls: the retrigger is older, it goes first
+    repeat.release(NOTE);
+    TEST_ASSERT_EQUAL(4, usbHost.packets.size());
+    TEST_ASSERT_EQUAL_HEX32(noteOn, usbHost.packets[0]);
+    TEST_ASSERT_EQUAL_HEX32(noteOff, usbHost.packets[1]);
+    TEST_ASSERT_EQUAL_HEX32(noteOn, usbHost.packets[2]);
+    TEST_ASSERT_EQUAL_HEX32(noteOff, usbHost.packets[3]);
+    TEST_ASSERT_FALSE(noteSounding());
+
+    // Nothing left for poll() to send after the release
+    usbHost.setTxBusy(false);
+    usbOut.poll();
+    TEST_ASSERT_EQUAL(4, usbHost.packets.size());
+}
+
+void test_deferred_sent_by_poll_once_endpoint_idle() {
+    usbHost.setTxBusy(true);
+    TEST_ASSERT_EQUAL(static_cast<int>(IsrWrite::Deferred),
+                      static_cast<int>(retriggerFromIsr()));
+
+    usbOut.poll();
+    TEST_ASSERT_EQUAL(0, usbHost.packets.size());
+
+    usbHost.setTxBusy(false);
+    usbOut.poll();
+    TEST_ASSERT_EQUAL(2, usbHost.packets.size());
+    TEST_ASSERT_EQUAL_HEX32(noteOff, usbHost.packets[0]);
+    TEST_ASSERT_EQUAL_HEX32(noteOn, usbHost.packets[1]);
+    TEST_ASSERT_EQUAL(1, usbHost.flushes);
+}
+
+void test_deferred_sent_before_flush_and_sysex() {
+    usbHost.setTxBusy(true);
+    retriggerFromIsr();
+    usbOut.flush();
+    TEST_ASSERT_EQUAL(2, usbHost.packets.size());
+    TEST_ASSERT_EQUAL(1, usbHost.flushes);
+
+    retriggerFromIsr();
+    const uint8_t dump[] = {0xF0, 0x7D, 0x01, 0xF7};
+    usbOut.sendSysEx(dump, sizeof(dump));
+    TEST_ASSERT_EQUAL(4, usbHost.sysexAt);
+    TEST_ASSERT_EQUAL(4, usbHost.packets.size());
+}
+
+void test_stall_drops_notes_and_replays_all_notes_off() {
+    const uint32_t cc = packUsbMidi(Cin::ControlChange, CH, 20, 64);
+
+    usbHost.stallUs = 3000;
+    usbOut.write(cc);
+    TEST_ASSERT_EQUAL(static_cast<int>(OutputMode::Collapse),
+                      static_cast<int>(usbOut.mode()));
+
+    // Held output: the note is dropped, its channel marked
+    usbOut.write(noteOff);
+    TEST_ASSERT_EQUAL(0, usbHost.packets.size());
+    TEST_ASSERT_EQUAL_HEX16(1u << CH, usbOut.notesOffPending());
+
+    TEST_ASSERT_TRUE(usbOut.poll());
+    std::this_thread::sleep_for(
+        std::chrono::milliseconds(decltype(usbOut)::SETTLE_MS + 10));
+    TEST_ASSERT_FALSE(usbOut.poll());
+
+    TEST_ASSERT_EQUAL(2, usbHost.packets.size());
+    TEST_ASSERT_EQUAL_HEX32(packUsbMidi(Cin::ControlChange, CH, 123, 0), usbHost.packets[0]);
+    TEST_ASSERT_EQUAL_HEX32(cc, usbHost.packets[1]);
+    TEST_ASSERT_EQUAL(static_cast<int>(OutputMode::Direct),
+                      static_cast<int>(usbOut.mode()));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_deferred_retrigger_goes_out_before_release);
+    RUN_TEST(test_deferred_sent_by_poll_once_endpoint_idle);
+    RUN_TEST(test_deferred_sent_before_flush_and_sysex);
+    RUN_TEST(test_stall_drops_notes_and_replays_all_notes_off);
+    return UNITY_END();
+}
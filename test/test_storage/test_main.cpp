@@ -0,0 +1,228 @@
+/**
+ * @file test_main.cpp
+ * @brief FlashJournal on RamFlashRegion: worst-case power-fail write time
+ *        for the largest records, and power fail while loop() holds the journal
+ *
+ * pio test -e native -f test_storage -v   (prints the timing lines)
+ */
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+#include <unity.h>
+
+#include "storage/FlashJournal.hpp"
+
+using minimal::storage::FlashJournal;
+using minimal::storage::RamFlashRegion;
+using minimal::storage::SECTOR_SIZE;
+
+namespace {
+
+/// Hold-up budget of the example (Config::POWER_FAIL_HOLDUP_US)
+constexpr uint32_t HOLDUP_US = 5000;
+
+// Payloads are padded by hand: records are compared bytewise
+
+/// Example state: 4 encoder positions + one toggle
+struct Example {
+    uint16_t positions[4];
+    uint8_t button2;
+    uint8_t pad;
+};
+
+/// 16 encoders, 4 banks of toggles
+struct SixteenEncoders {
+    uint16_t positions[16];
+    uint8_t toggles[4];
+};
+
+/// 64 parameters at 16 bits plus a bank byte
+struct SixtyFourParams {
+    uint16_t values[64];
+    uint8_t bank;
+    uint8_t pad;
+};
+
+/// Largest payload that still fits one page with the record header and CRC
+struct OnePage {
+    uint8_t bytes[256 - 12];
+};
+
+template <typename Payload>
+Payload pattern(uint32_t seed) {
+    Payload p;
+    auto* bytes = reinterpret_cast<uint8_t*>(&p);
+    for (uint32_t i = 0; i < sizeof(p); ++i) bytes[i] = static_cast<uint8_t>(seed * 31 + i);
+    return p;
+}
+
+struct SaveCycle {
+    uint32_t recordSize;
+    uint32_t boundUs;
+    uint32_t worstUs = 0;   ///< worst simulated device time of one bounded append
+    bool allWritten = true;
+    bool anyErase = false;  ///< an appendPrepared() that erased
+    bool newestRestored = false;
+};
+
+/// loop()'s save cycle (prepare, then the bounded append) over three passes of the region
+template <typename Payload>
+SaveCycle runSaveCycle(const char* name) {
+    using Journal = FlashJournal<Payload, RamFlashRegion<2>>;
+    static Journal journal{RamFlashRegion<2>()};
+    Payload restored;
+    journal.restore(restored);
+
+    SaveCycle run{Journal::RECORD_SIZE, Journal::WORST_CASE_APPEND_US};
+    uint32_t appends = 3 * journal.region().size() / Journal::RECORD_SIZE;
+    for (uint32_t i = 0; i < appends; ++i) {
+        journal.prepare();
+        uint32_t erased = journal.region().erasedSectors;
+        run.allWritten &= journal.appendPrepared(pattern<Payload>(i));
+        run.anyErase |= journal.region().erasedSectors != erased;
+        uint32_t us = journal.region().lastOperationUs + minimal::storage::timing::RECORD_OVERHEAD_US;
+        if (us > run.worstUs) run.worstUs = us;
+    }
+    Payload expected = pattern<Payload>(appends - 1);
+    run.newestRestored = journal.restore(restored) &&
+                         std::memcmp(&expected, &restored, sizeof(Payload)) == 0;
+
+    char line[128];
+    std::snprintf(line, sizeof(line), "BENCH snapshot %s: %u B record, worst %u us (bound %u, hold-up %u)",
+                  name, static_cast<unsigned>(run.recordSize), static_cast<unsigned>(run.worstUs),
+                  static_cast<unsigned>(run.boundUs), static_cast<unsigned>(HOLDUP_US));
+    TEST_MESSAGE(line);
+    return run;
+}
+
+void checkFitsHoldup(const SaveCycle& run) {
+    TEST_ASSERT_TRUE(run.allWritten);
+    TEST_ASSERT_FALSE(run.anyErase);
+    TEST_ASSERT_TRUE(run.newestRestored);
+    TEST_ASSERT_LESS_OR_EQUAL(run.boundUs, run.worstUs);
+    TEST_ASSERT_LESS_OR_EQUAL(HOLDUP_US, run.worstUs);
+}
+
+/// Region that runs a "power-fail interrupt" in the middle of each operation
+struct InterruptedRegion {
+    RamFlashRegion<2>* flash;
+    void (*interrupt)(void*) = nullptr;
+    void* ctx = nullptr;
+
+    uint32_t size() const { return flash->size(); }
+    const uint8_t* data(uint32_t offset) const { return flash->data(offset); }
+    void program(uint32_t offset, const void* src, uint32_t length) {
+        fire();
+        flash->program(offset, src, length);
+    }
+    void eraseSector(uint32_t offset) {
+        flash->eraseSector(offset);
+        fire();  // the erase itself runs with interrupts disabled
+    }
+    void fire() {
+        if (interrupt) interrupt(ctx);
+    }
+};
+
+using InterruptedJournal = FlashJournal<Example, InterruptedRegion>;
+
+struct PowerFailProbe {
+    InterruptedJournal* journal;
+    uint32_t attempts = 0;
+    uint32_t written = 0;
+};
+
+void onPowerFail(void* ctx) {
+    auto* probe = static_cast<PowerFailProbe*>(ctx);
+    ++probe->attempts;
+    if (probe->journal->appendPrepared(pattern<Example>(999))) ++probe->written;
+}
+
+}  // namespace
+
+void setUp() {}
+void tearDown() {}
+
+void test_example_record_fits_holdup() {
+    checkFitsHoldup(runSaveCycle<Example>("example"));
+}
+
+void test_sixteen_encoders_fit_holdup() {
+    checkFitsHoldup(runSaveCycle<SixteenEncoders>("16 encoders"));
+}
+
+void test_sixty_four_params_fit_holdup() {
+    checkFitsHoldup(runSaveCycle<SixtyFourParams>("64 params"));
+}
+
+/// The largest one-page record reaches the static bound the firmware asserts
+void test_one_page_record_reaches_bound() {
+    SaveCycle run = runSaveCycle<OnePage>("one page");
+    checkFitsHoldup(run);
+    TEST_ASSERT_EQUAL_UINT32(256, run.recordSize);
+    TEST_ASSERT_EQUAL_UINT32(run.boundUs, run.worstUs);
+}
+
+void test_power_fail_during_prepare_backs_off() {
+    static RamFlashRegion<2> flash;
+    InterruptedJournal journal{InterruptedRegion{&flash}};
+    Example restored;
+    journal.restore(restored);
+    // Fill both sectors, so prepare() erases the first one again
+    for (uint32_t i = 0; i < 2 * SECTOR_SIZE / InterruptedJournal::RECORD_SIZE; ++i) {
+        journal.append(pattern<Example>(i));
+    }
+
+    PowerFailProbe probe{&journal};
+    journal.region().interrupt = &onPowerFail;
+    journal.region().ctx = &probe;
+    uint32_t sequence = journal.sequence();
+    journal.prepare();
+    journal.region().interrupt = nullptr;
+
+    TEST_ASSERT_EQUAL_UINT32(1, flash.erasedSectors);
+    TEST_ASSERT_EQUAL_UINT32(1, probe.attempts);
+    TEST_ASSERT_EQUAL_UINT32(0, probe.written);
+    TEST_ASSERT_EQUAL_UINT32(sequence, journal.sequence());
+    TEST_ASSERT_FALSE(journal.writing());
+
+    // The erase completed: the next bounded write goes to the fresh sector
+    TEST_ASSERT_TRUE(journal.appendPrepared(pattern<Example>(7)));
+    TEST_ASSERT_TRUE(journal.restore(restored));
+    Example expected = pattern<Example>(7);
+    TEST_ASSERT_EQUAL_MEMORY(&expected, &restored, sizeof(Example));
+}
+
+void test_power_fail_during_append_leaves_one_valid_record() {
+    static RamFlashRegion<2> flash;
+    InterruptedJournal journal{InterruptedRegion{&flash}};
+    Example restored;
+    journal.restore(restored);
+    journal.prepare();
+
+    PowerFailProbe probe{&journal};
+    journal.region().interrupt = &onPowerFail;
+    journal.region().ctx = &probe;
+    TEST_ASSERT_TRUE(journal.appendPrepared(pattern<Example>(1)));
+    journal.region().interrupt = nullptr;
+
+    TEST_ASSERT_EQUAL_UINT32(1, probe.attempts);
+    TEST_ASSERT_EQUAL_UINT32(0, probe.written);
+    TEST_ASSERT_TRUE(journal.restore(restored));
+    TEST_ASSERT_EQUAL_UINT32(1, journal.sequence());
+    Example expected = pattern<Example>(1);
+    TEST_ASSERT_EQUAL_MEMORY(&expected, &restored, sizeof(Example));
+}
+
+int main() {
+    UNITY_BEGIN();
+    RUN_TEST(test_example_record_fits_holdup);
+    RUN_TEST(test_sixteen_encoders_fit_holdup);
+    RUN_TEST(test_sixty_four_params_fit_holdup);
+    RUN_TEST(test_one_page_record_reaches_bound);
+    RUN_TEST(test_power_fail_during_prepare_backs_off);
+    RUN_TEST(test_power_fail_during_append_leaves_one_valid_record);
+    return UNITY_END();
+}